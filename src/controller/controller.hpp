@@ -2,81 +2,228 @@
 #define A7_DNA_ANALYZER_1_1_CONTROLLER_CONTROLLER_HPP_
 
 #include <list>
+#include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "../model/approximate_search.hpp"
 #include "../model/dna_search.hpp"
+#include "../model/incremental_search.hpp"
+#include "../model/iupac_search.hpp"
 #include "../model/k_strings.hpp"
+#include "../model/kmer_counter.hpp"
 #include "../model/regex.hpp"
+#include "../model/regex_program.hpp"
 #include "../model/sequence_alignment.hpp"
+#include "../model/sketch.hpp"
 #include "../model/window_substring.hpp"
+#include "job_runner.hpp"
+#include "shard_coordinator.hpp"
 
 namespace s21 {
 class Controller {
  public:
   using Sequences = NeedlemanWunsch::Sequences;
+  using Alignment = NeedlemanWunsch::Alignment;
 
   Controller() = default;
   ~Controller() = default;
 
-  std::list<int> AlgorithmRK(std::string_view text, std::string_view pattern) {
-    rk_.SetText(text);
-    rk_.SetPattern(pattern);
-    return rk_.GetPositions();
+  std::list<int> AlgorithmRK(std::string_view text,
+                             std::string_view pattern) const {
+    RabinKarp rk;
+    rk.SetText(text);
+    rk.SetPattern(pattern);
+    return rk.GetPositions();
   }
 
-  Sequences AlgorithmNW(std::string_view path) {
-    nw_.ReadFile(path);
-    return nw_.GetOptimalAlignment();
+  RabinKarp::QueryResult AlgorithmRKQuery(std::string_view text,
+                                          std::string_view pattern,
+                                          RabinKarp::QueryMode mode,
+                                          std::size_t n = 0) const {
+    RabinKarp rk;
+    rk.SetText(text);
+    rk.SetPattern(pattern);
+    return rk.Query(mode, n);
+  }
+
+  std::list<StrandHit> AlgorithmRKBothStrands(std::string_view text,
+                                              std::string_view pattern) const {
+    RabinKarp rk;
+    rk.SetText(text);
+    rk.SetPattern(pattern);
+    return rk.GetStrandPositions();
+  }
+
+  const std::vector<std::size_t> &StartIncrementalRK(std::string_view text,
+                                                     std::string_view pattern) {
+    this->incremental_ = IncrementalSearch(text, pattern);
+    return this->incremental_.Positions();
+  }
+
+  const std::vector<std::size_t> &AlgorithmRKEdit(
+      std::size_t pos, std::size_t count, std::string_view replacement) {
+    this->incremental_.Replace(pos, count, replacement);
+    return this->incremental_.Positions();
+  }
+
+  std::list<int> AlgorithmIupac(std::string_view text,
+                                std::string_view pattern) const {
+    return IupacSearch::Search(text, pattern);
+  }
+
+  std::list<ApproximateHit> AlgorithmApproximate(
+      std::string_view text, std::string_view pattern, int max_errors,
+      ApproximateSearch::Mode mode) const {
+    return ApproximateSearch::Search(text, pattern, max_errors, mode);
+  }
+
+  Sequences AlgorithmNW(std::string_view path) const {
+    NeedlemanWunsch nw;
+    nw.ReadFile(path);
+    return nw.GetOptimalAlignment();
   }
 
   Sequences AlgorithmNW(int gap, int match, int mismatch,
-                        std::string_view subseq_a, std::string_view subseq_b) {
-    nw_.SetGapScore(gap);
-    nw_.SetMatchScore(match);
-    nw_.SetMismatchScore(mismatch);
-    nw_.SetSeq(subseq_a, subseq_b);
-    return nw_.GetOptimalAlignment();
+                        std::string_view subseq_a,
+                        std::string_view subseq_b) const {
+    return NeedlemanWunsch::Align(subseq_a, subseq_b, {match, mismatch, gap});
+  }
+
+  Alignment AlgorithmNWCigar(std::string_view path) const {
+    NeedlemanWunsch nw;
+    nw.ReadFile(path);
+    return nw.GetAlignment();
+  }
+
+  Alignment AlgorithmNWCigar(int gap, int match, int mismatch,
+                             std::string_view subseq_a,
+                             std::string_view subseq_b) const {
+    return NeedlemanWunsch::AlignCigar(subseq_a, subseq_b,
+                                       {match, mismatch, gap});
+  }
+
+  using SketchPair = std::pair<const MinHashSketch *, const MinHashSketch *>;
+
+  std::vector<std::optional<Sequences>> AlgorithmNWBatch(
+      const std::vector<std::pair<std::string_view, std::string_view>> &pairs,
+      int gap, int match, int mismatch, double min_ani = 0.0,
+      int k = MinHashSketch::kDefaultK) const {
+    std::unordered_map<std::string_view, MinHashSketch> cache;
+    std::vector<SketchPair> sketches;
+    if (min_ani > 0.0) {
+      auto sketch = [&cache, k](std::string_view seq) {
+        auto it = cache.find(seq);
+        if (it == cache.end())
+          it = cache.emplace(seq, MinHashSketch::Build(seq, k)).first;
+        return &it->second;
+      };
+      for (auto [seq_a, seq_b] : pairs)
+        sketches.push_back({sketch(seq_a), sketch(seq_b)});
+    }
+    return this->AlgorithmNWBatch(pairs, sketches, gap, match, mismatch,
+                                  min_ani);
+  }
+
+  std::vector<std::optional<Sequences>> AlgorithmNWBatch(
+      const std::vector<std::pair<std::string_view, std::string_view>> &pairs,
+      const std::vector<SketchPair> &sketches, int gap, int match,
+      int mismatch, double min_ani) const {
+    std::vector<std::optional<Sequences>> results(pairs.size());
+    for (std::size_t i = 0; i < pairs.size(); i++) {
+      auto [seq_a, seq_b] = pairs[i];
+      if (min_ani > 0.0 && i < sketches.size()) {
+        auto [sketch_a, sketch_b] = sketches[i];
+        if (sketch_a != nullptr && sketch_b != nullptr &&
+            !sketch_a->Empty() && !sketch_b->Empty() &&
+            sketch_a->Ani(*sketch_b) < min_ani)
+          continue;
+      }
+      results[i] = NeedlemanWunsch::Align(seq_a, seq_b, {match, mismatch, gap});
+    }
+    return results;
+  }
+
+  void StartShards(std::string_view path, std::size_t workers) {
+    this->shards_ = std::make_unique<ShardCoordinator>(path, workers);
+  }
+
+  std::optional<std::list<ShardCoordinator::Hit>> AlgorithmShardSearch(
+      std::string_view pattern,
+      ShardCoordinator::Engine engine = ShardCoordinator::Engine::kExact,
+      int max_errors = 0) const {
+    if (this->shards_ == nullptr) return std::nullopt;
+    return this->shards_->Search(pattern, engine, max_errors);
+  }
+
+  KmerCounter AlgorithmKmers(
+      std::string_view text, int k, bool canonical = true,
+      KmerCounter::Mode mode = KmerCounter::Mode::kExact) const {
+    KmerCounter counter(k, canonical, mode);
+    counter.Count(text);
+    return counter;
+  }
+
+  std::optional<JobRunner::Progress> AlgorithmNWJob(
+      const std::vector<std::string> &sequences, int gap, int match,
+      int mismatch, std::string_view output, std::string_view checkpoint,
+      JobRunner::Options options = {}) const {
+    return JobRunner(output, checkpoint, options)
+        .AlignAllPairs(sequences, {match, mismatch, gap});
+  }
+
+  std::optional<JobRunner::Progress> AlgorithmRKJob(
+      std::string_view path, const std::vector<std::string> &patterns,
+      std::string_view output, std::string_view checkpoint,
+      JobRunner::Options options = {}) const {
+    return JobRunner(output, checkpoint, options).ScanFile(path, patterns);
+  }
+
+  bool RegularExpressions(std::string_view path) const {
+    Regex rg;
+    rg.ReadFile(path);
+    return rg.IsMatch();
   }
 
-  bool RegularExpressions(std::string_view path) {
-    rg_.ReadFile(path);
-    return rg_.IsMatch();
+  bool RegularExpressions(std::string_view str, std::string_view expr) const {
+    return RegexCache::Shared().Get(expr)->IsMatch(str);
   }
 
-  bool RegularExpressions(std::string_view str, std::string_view expr) {
-    rg_.SetString(str);
-    rg_.SetExpression(expr);
-    return rg_.IsMatch();
+  std::vector<bool> RegularExpressionSet(
+      std::string_view str, const std::vector<std::string_view> &exprs,
+      bool search = false) const {
+    RegexProgram program(exprs);
+    return search ? program.Search(str) : program.Match(str);
   }
 
-  int KStrings(std::string_view path) {
-    ks_.ReadFile(path);
-    return ks_.GetDiffCount();
+  int KStrings(std::string_view path) const {
+    KString ks;
+    ks.ReadFile(path);
+    return ks.GetDiffCount();
   }
 
-  int KStrings(std::string_view str_a, std::string_view str_b) {
-    ks_.SetStrings(str_a, str_b);
-    return ks_.GetDiffCount();
+  int KStrings(std::string_view str_a, std::string_view str_b) const {
+    return KString::GetDiffCount(str_a, str_b);
   }
 
-  std::string MinimumWindowSubstring(std::string_view path) {
-    ws_.ReadFile(path);
-    return ws_.GetMinimumWindowSubstring();
+  std::string MinimumWindowSubstring(std::string_view path) const {
+    WindowSubstring ws;
+    ws.ReadFile(path);
+    return ws.GetMinimumWindowSubstring();
   }
 
   std::string MinimumWindowSubstring(std::string_view str,
-                                     std::string_view pattern) {
-    ws_.SetString(str);
-    ws_.SetPattern(pattern);
-    return ws_.GetMinimumWindowSubstring();
+                                     std::string_view pattern) const {
+    return WindowSubstring::GetMinimumWindowSubstring(str, pattern);
   }
 
  private:
-  Regex rg_;
-  KString ks_;
-  RabinKarp rk_;
-  NeedlemanWunsch nw_;
-  WindowSubstring ws_;
+  std::unique_ptr<ShardCoordinator> shards_;
+  IncrementalSearch incremental_;
 };
 }  // namespace s21
 
@@ -0,0 +1,239 @@
+#ifndef A7_DNA_ANALYZER_1_1_CONTROLLER_JOB_RUNNER_HPP_
+#define A7_DNA_ANALYZER_1_1_CONTROLLER_JOB_RUNNER_HPP_
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../model/dna_search.hpp"
+#include "../model/mapped_file.hpp"
+#include "../model/metrics.hpp"
+#include "../model/sequence_alignment.hpp"
+
+namespace fs = std::filesystem;
+
+namespace s21 {
+class JobRunner {
+ public:
+  static constexpr std::size_t kDefaultMemoryBudget = std::size_t{256} << 20;
+  static constexpr std::size_t kDefaultCheckpointEvery = 16;
+  static constexpr std::size_t kDefaultMaxPairsPerUnit = 64;
+  static constexpr std::size_t kLineOverhead = 64;
+  static constexpr std::size_t kMinShard = 1 << 10;
+
+  struct Options {
+    std::size_t memory_budget{kDefaultMemoryBudget};
+    std::size_t checkpoint_every{kDefaultCheckpointEvery};
+    std::size_t max_pairs_per_unit{kDefaultMaxPairsPerUnit};
+    std::size_t max_units{std::numeric_limits<std::size_t>::max()};
+  };
+
+  struct Progress {
+    std::size_t next_unit{};
+    std::size_t total_units{};
+    std::uint64_t output_bytes{};
+
+    bool Done() const noexcept { return this->next_unit >= this->total_units; }
+  };
+
+  JobRunner(std::string_view output_path, std::string_view checkpoint_path)
+      : JobRunner(output_path, checkpoint_path, Options{}) {}
+  JobRunner(std::string_view output_path, std::string_view checkpoint_path,
+            Options options)
+      : output_path_(output_path),
+        checkpoint_path_(checkpoint_path),
+        options_(options) {
+    this->options_.checkpoint_every =
+        std::max<std::size_t>(this->options_.checkpoint_every, 1);
+    this->options_.max_pairs_per_unit =
+        std::max<std::size_t>(this->options_.max_pairs_per_unit, 1);
+  }
+  ~JobRunner() = default;
+
+  std::optional<Progress> AlignAllPairs(
+      const std::vector<std::string> &sequences,
+      const NeedlemanWunsch::Scoring &scoring) {
+    const std::size_t count = sequences.size();
+    const std::size_t pairs = count < 2 ? 0 : count * (count - 1) / 2;
+    std::size_t longest = 0;
+    for (const std::string &sequence : sequences)
+      longest = std::max(longest, sequence.size());
+    // A CIGAR takes at most two characters per aligned column.
+    const std::size_t line_bytes = kLineOverhead + 4 * longest;
+    const std::size_t per_unit =
+        std::clamp<std::size_t>(this->options_.memory_budget / line_bytes, 1,
+                                this->options_.max_pairs_per_unit);
+
+    std::uint64_t fingerprint = Mix(kFnvOffset, "align");
+    for (const std::string &sequence : sequences)
+      fingerprint = Mix(Mix(fingerprint, sequence), "\n");
+    fingerprint = Mix(fingerprint, std::to_string(scoring.match) + " " +
+                                       std::to_string(scoring.mismatch) +
+                                       " " + std::to_string(scoring.gap) +
+                                       " " + std::to_string(per_unit) + " " +
+                                       std::to_string(
+                                           this->options_.memory_budget));
+
+    return this->Run(
+        fingerprint, (pairs + per_unit - 1) / per_unit,
+        [&](std::size_t unit, std::string &out) {
+          const std::size_t first = unit * per_unit;
+          const std::size_t last = std::min(first + per_unit, pairs);
+          std::size_t i = 0;
+          std::size_t offset = first;
+          while (offset >= count - 1 - i) {
+            offset -= count - 1 - i;
+            i++;
+          }
+          std::size_t j = i + 1 + offset;
+          for (std::size_t k = first; k < last; k++) {
+            const std::string &seq_a = sequences[i];
+            const std::string &seq_b = sequences[j];
+            bool fits =
+                NeedlemanWunsch::MatrixBytes(seq_a.size(), seq_b.size(),
+                                             scoring) <=
+                this->options_.memory_budget;
+            auto alignment =
+                fits ? NeedlemanWunsch::AlignCigar(seq_a, seq_b, scoring)
+                     : NeedlemanWunsch::AlignLinear(seq_a, seq_b, scoring);
+            if (!fits) S21_METRICS_COUNT("dna_job_linear_alignments_total", 1);
+            out += std::to_string(i) + "\t" + std::to_string(j) + "\t" +
+                   std::to_string(alignment.optimal_score) + "\t" +
+                   alignment.Cigar() + "\n";
+            if (++j == count) j = ++i + 1;
+          }
+        });
+  }
+
+  std::optional<Progress> ScanFile(std::string_view text_path,
+                                   const std::vector<std::string> &patterns) {
+    std::size_t overlap = 0;
+    for (const std::string &pattern : patterns)
+      overlap = std::max(overlap, pattern.size());
+    overlap = overlap > 0 ? overlap - 1 : 0;
+    const std::size_t budget = this->options_.memory_budget;
+    const std::size_t shard =
+        std::max(budget > overlap ? budget - overlap : 0, kMinShard);
+    const std::size_t size = MappedFile::FileSize(text_path);
+
+    std::uint64_t fingerprint = Mix(kFnvOffset, "scan");
+    fingerprint = Mix(Mix(fingerprint, text_path), "\n");
+    for (const std::string &pattern : patterns)
+      fingerprint = Mix(Mix(fingerprint, pattern), "\n");
+    fingerprint = Mix(fingerprint, std::to_string(size) + " " +
+                                       std::to_string(shard));
+
+    return this->Run(
+        fingerprint, (size + shard - 1) / shard,
+        [&](std::size_t unit, std::string &out) {
+          const std::size_t begin = unit * shard;
+          const std::size_t owned = std::min(shard, size - begin);
+          MappedFile text(text_path, begin, owned + overlap);
+          for (std::size_t p = 0; p < patterns.size(); p++)
+            for (int pos : RabinKarp::Search(text.View(), patterns[p]))
+              if (static_cast<std::size_t>(pos) < owned)
+                out += std::to_string(p) + "\t" +
+                       std::to_string(begin + pos) + "\n";
+        });
+  }
+
+ private:
+  static constexpr std::string_view kMagic = "s21-job-checkpoint";
+  static constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+  static constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+  std::string output_path_;
+  std::string checkpoint_path_;
+  Options options_;
+
+  static std::uint64_t Mix(std::uint64_t hash, std::string_view bytes) {
+    for (char symbol : bytes)
+      hash = (hash ^ static_cast<unsigned char>(symbol)) * kFnvPrime;
+    return hash;
+  }
+
+  template <typename Work>
+  std::optional<Progress> Run(std::uint64_t fingerprint, std::size_t units,
+                              Work work) {
+    S21_METRICS_TIMER("dna_job_run_ns");
+    Progress progress = this->Load(fingerprint);
+    progress.total_units = units;
+
+    std::error_code error;
+    { std::ofstream touch(fs::path(this->output_path_), std::ios::app); }
+    fs::resize_file(this->output_path_, progress.output_bytes, error);
+    if (error) return std::nullopt;
+    std::ofstream output(fs::path(this->output_path_),
+                         std::ios::binary | std::ios::app);
+    if (!output.is_open()) return std::nullopt;
+
+    std::string chunk;
+    for (std::size_t done = 0;
+         !progress.Done() && done < this->options_.max_units; done++) {
+      chunk.clear();
+      work(progress.next_unit, chunk);
+      output.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+      progress.output_bytes += chunk.size();
+      progress.next_unit++;
+      S21_METRICS_COUNT("dna_job_units_total", 1);
+      if ((done + 1) % this->options_.checkpoint_every == 0 &&
+          !this->Save(fingerprint, progress, output))
+        return std::nullopt;
+    }
+    if (!this->Save(fingerprint, progress, output)) return std::nullopt;
+    return progress;
+  }
+
+  Progress Load(std::uint64_t fingerprint) const {
+    std::ifstream file(fs::path(this->checkpoint_path_), std::ios::in);
+    std::string magic;
+    std::uint64_t stored = 0;
+    Progress progress;
+    if (!(file >> magic >> stored >> progress.next_unit >>
+          progress.output_bytes) ||
+        magic != kMagic || stored != fingerprint ||
+        MappedFile::FileSize(this->output_path_) < progress.output_bytes)
+      return {};
+    return progress;
+  }
+
+  bool Save(std::uint64_t fingerprint, const Progress &progress,
+            std::ofstream &output) const {
+    if (!output.flush() || !Sync(this->output_path_)) return false;
+    const std::string temporary = this->checkpoint_path_ + ".tmp";
+    {
+      std::ofstream file(fs::path(temporary), std::ios::trunc);
+      file << kMagic << " " << fingerprint << " " << progress.next_unit << " "
+           << progress.output_bytes << "\n";
+      if (!file.flush()) return false;
+    }
+    if (!Sync(temporary)) return false;
+    std::error_code error;
+    fs::rename(temporary, this->checkpoint_path_, error);
+    if (error) return false;
+    fs::path directory = fs::path(this->checkpoint_path_).parent_path();
+    Sync(directory.empty() ? "." : directory.string());
+    S21_METRICS_COUNT("dna_job_checkpoints_total", 1);
+    return true;
+  }
+
+  static bool Sync(const std::string &path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool synced = ::fsync(fd) == 0;
+    ::close(fd);
+    return synced;
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_CONTROLLER_JOB_RUNNER_HPP_
@@ -0,0 +1,227 @@
+#ifndef A7_DNA_ANALYZER_1_1_CONTROLLER_QUERY_SERVICE_HPP_
+#define A7_DNA_ANALYZER_1_1_CONTROLLER_QUERY_SERVICE_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../model/dna_search.hpp"
+#include "../model/k_strings.hpp"
+#include "../model/kmer_counter.hpp"
+#include "../model/regex_program.hpp"
+#include "../model/sequence_alignment.hpp"
+#include "../model/thread_pool.hpp"
+#include "../model/window_substring.hpp"
+
+namespace fs = std::filesystem;
+
+namespace s21 {
+class QueryService {
+ public:
+  enum class Algorithm { kRabinKarp, kNeedlemanWunsch, kRegex, kKStrings,
+                         kWindowSubstring, kKmers };
+
+  struct Request {
+    std::size_t id{};
+    Algorithm algorithm{};
+    std::vector<std::string> args;
+  };
+
+  struct Response {
+    std::size_t id{};
+    bool ok{};
+    std::string result;
+    double latency_us{};
+  };
+
+  struct LatencyStats {
+    std::size_t count{};
+    double p50_us{};
+    double p99_us{};
+  };
+
+  explicit QueryService(std::size_t threads = ThreadPool::DefaultThreads())
+      : pool_(threads) {}
+  ~QueryService() = default;
+
+  bool LoadReference(std::string_view name, std::string_view path) {
+    std::ifstream file(fs::path(path), std::ios::binary | std::ios::in);
+    if (!file.is_open()) return false;
+    auto text = std::make_shared<std::string>(
+        std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    std::unique_lock<std::shared_mutex> lock(this->references_mutex_);
+    this->references_[std::string(name)] = std::move(text);
+    return true;
+  }
+
+  std::vector<Response> Process(const std::vector<Request> &batch) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Response> responses(batch.size());
+
+    std::map<Algorithm, std::vector<std::size_t>> groups;
+    for (std::size_t i = 0; i < batch.size(); i++)
+      groups[batch[i].algorithm].push_back(i);
+
+    std::vector<std::future<void>> futures;
+    for (const auto &group : groups) {
+      const std::vector<std::size_t> &indexes = group.second;
+      for (std::size_t first = 0; first < indexes.size();
+           first += kRequestsPerTask) {
+        std::size_t last = std::min(first + kRequestsPerTask, indexes.size());
+        futures.push_back(this->pool_.Submit([&, first, last]() {
+          for (std::size_t k = first; k < last; k++) {
+            std::size_t index = indexes[k];
+            responses[index] = this->Execute(batch[index]);
+            responses[index].latency_us =
+                std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+          }
+        }));
+      }
+    }
+    for (auto &future : futures) future.get();
+
+    std::lock_guard<std::mutex> lock(this->latency_mutex_);
+    for (const auto &response : responses) {
+      this->latencies_.push_back(response.latency_us);
+      if (this->latencies_.size() > kLatencyWindow)
+        this->latencies_.pop_front();
+    }
+    return responses;
+  }
+
+  LatencyStats GetLatencyStats() const {
+    std::vector<double> latencies;
+    {
+      std::lock_guard<std::mutex> lock(this->latency_mutex_);
+      latencies.assign(this->latencies_.begin(), this->latencies_.end());
+    }
+    LatencyStats stats;
+    stats.count = latencies.size();
+    if (latencies.empty()) return stats;
+    stats.p50_us = Percentile(latencies, 0.50);
+    stats.p99_us = Percentile(latencies, 0.99);
+    return stats;
+  }
+
+ private:
+  static constexpr std::size_t kRequestsPerTask = 64;
+  static constexpr std::size_t kLatencyWindow = 100000;
+
+  using Reference = std::shared_ptr<const std::string>;
+
+  ThreadPool pool_;
+  mutable std::shared_mutex references_mutex_;
+  std::map<std::string, Reference, std::less<>> references_;
+  mutable std::mutex latency_mutex_;
+  std::deque<double> latencies_;
+
+  static double Percentile(std::vector<double> &values, double rank) {
+    std::size_t index = static_cast<std::size_t>(rank * (values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+  }
+
+  class UnknownReference : public std::runtime_error {
+   public:
+    explicit UnknownReference(const std::string &name)
+        : std::runtime_error("unknown reference " + name) {}
+  };
+
+  Reference Resolve(const std::string &arg) const {
+    if (arg.size() > 1 && arg[0] == '@') {
+      std::shared_lock<std::shared_mutex> lock(this->references_mutex_);
+      auto it = this->references_.find(std::string_view(arg).substr(1));
+      if (it == this->references_.end()) throw UnknownReference(arg);
+      return it->second;
+    }
+    return std::make_shared<const std::string>(arg);
+  }
+
+  Response Execute(const Request &request) const {
+    Response response{request.id, false, "", 0};
+    const auto &args = request.args;
+    try {
+      switch (request.algorithm) {
+        case Algorithm::kRabinKarp: {
+          if (args.size() != 2) break;
+          Reference text = this->Resolve(args[0]);
+          Reference pattern = this->Resolve(args[1]);
+          for (int pos : RabinKarp::Search(*text, *pattern))
+            response.result += std::to_string(pos) + " ";
+          if (!response.result.empty()) response.result.pop_back();
+          response.ok = true;
+          break;
+        }
+        case Algorithm::kNeedlemanWunsch: {
+          if (args.size() != 5) break;
+          NeedlemanWunsch::Scoring scoring{
+              std::stoi(args[0]), std::stoi(args[1]), std::stoi(args[2])};
+          auto alignment = NeedlemanWunsch::AlignCigar(
+              *this->Resolve(args[3]), *this->Resolve(args[4]), scoring);
+          response.result = std::to_string(alignment.optimal_score) + " " +
+                            alignment.Cigar();
+          response.ok = true;
+          break;
+        }
+        case Algorithm::kRegex: {
+          if (args.size() != 2) break;
+          auto program = RegexCache::Shared().Get(args[1]);
+          bool is_match = program->IsMatch(*this->Resolve(args[0]));
+          response.result = is_match ? "true" : "false";
+          response.ok = true;
+          break;
+        }
+        case Algorithm::kKStrings: {
+          if (args.size() != 2) break;
+          int count = KString::GetDiffCount(*this->Resolve(args[0]),
+                                            *this->Resolve(args[1]));
+          response.result = std::to_string(count);
+          response.ok = true;
+          break;
+        }
+        case Algorithm::kWindowSubstring: {
+          if (args.size() != 2) break;
+          response.result = WindowSubstring::GetMinimumWindowSubstring(
+              *this->Resolve(args[0]), *this->Resolve(args[1]));
+          response.ok = true;
+          break;
+        }
+        case Algorithm::kKmers: {
+          if (args.size() != 3) break;
+          KmerCounter counter(std::stoi(args[1]));
+          counter.Count(*this->Resolve(args[0]), 1);
+          for (const auto &top : counter.TopN(std::stoul(args[2])))
+            response.result += top.kmer + ":" + std::to_string(top.count) + " ";
+          if (!response.result.empty()) response.result.pop_back();
+          response.ok = true;
+          break;
+        }
+      }
+    } catch (const UnknownReference &error) {
+      response.ok = false;
+      response.result = error.what();
+    } catch (const std::exception &) {
+      response.ok = false;
+    }
+    if (!response.ok && response.result.empty())
+      response.result = "invalid arguments";
+    return response;
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_CONTROLLER_QUERY_SERVICE_HPP_
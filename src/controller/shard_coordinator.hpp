@@ -0,0 +1,261 @@
+#ifndef A7_DNA_ANALYZER_1_1_CONTROLLER_SHARD_COORDINATOR_HPP_
+#define A7_DNA_ANALYZER_1_1_CONTROLLER_SHARD_COORDINATOR_HPP_
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <filesystem>
+#include <ios>
+#include <iterator>
+#include <list>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../model/approximate_search.hpp"
+#include "../model/dna_search.hpp"
+#include "../model/iupac_search.hpp"
+#include "../model/mapped_file.hpp"
+#include "../model/metrics.hpp"
+
+namespace fs = std::filesystem;
+
+namespace s21 {
+class ShardCoordinator {
+ public:
+  enum class Engine : std::uint32_t { kExact, kIupac, kMismatch, kEdit };
+
+  struct Hit {
+    std::uint64_t position{};
+    int distance{};
+
+    bool operator==(const Hit &other) const noexcept {
+      return position == other.position && distance == other.distance;
+    }
+  };
+
+  static constexpr std::size_t kDefaultMaxQuerySize = 1 << 12;
+
+  // Workers are forked, so construct the coordinator before any threads
+  // start. Throws when the text cannot be opened or workers cannot start.
+  ShardCoordinator(std::string_view path, std::size_t workers,
+                   std::size_t max_query_size = kDefaultMaxQuerySize)
+      : path_(path),
+        max_query_size_(std::max<std::size_t>(max_query_size, 1)) {
+    if (!IsSingleThreaded())
+      throw std::logic_error(
+          "ShardCoordinator must be created before any threads start");
+    int fd = ::open(this->path_.c_str(), O_RDONLY);
+    if (fd < 0) throw std::ios_base::failure("failed to open " + this->path_);
+    ::close(fd);
+    const std::size_t size = MappedFile::FileSize(path);
+    workers =
+        std::clamp<std::size_t>(workers, 1, std::max<std::size_t>(size, 1));
+    for (std::size_t k = 0; k < workers; k++) {
+      Shard shard{size * k / workers, size * (k + 1) / workers};
+      if (!this->Spawn(shard)) {
+        this->Stop();
+        throw std::runtime_error("failed to start shard workers");
+      }
+      this->shards_.push_back(shard);
+    }
+  }
+
+  ShardCoordinator(const ShardCoordinator &) = delete;
+  ShardCoordinator &operator=(const ShardCoordinator &) = delete;
+
+  ~ShardCoordinator() { this->Stop(); }
+
+  bool IsRunning() const noexcept { return !this->shards_.empty(); }
+  std::size_t Workers() const noexcept { return this->shards_.size(); }
+
+  std::optional<std::list<Hit>> Search(std::string_view pattern,
+                                       Engine engine = Engine::kExact,
+                                       int max_errors = 0) {
+    S21_METRICS_TIMER("dna_shard_search_ns");
+    const std::size_t slack =
+        engine == Engine::kEdit ? std::max(max_errors, 0) : 0;
+    const std::size_t span = pattern.size() + slack;
+    if (!this->IsRunning() || pattern.empty() || span > this->max_query_size_)
+      return std::nullopt;
+
+    Header header{static_cast<std::uint32_t>(engine), max_errors,
+                  pattern.size()};
+    for (const Shard &shard : this->shards_)
+      if (!WriteAll(shard.fd, &header, sizeof(header)) ||
+          !WriteAll(shard.fd, pattern.data(), pattern.size())) {
+        this->Stop();
+        return std::nullopt;
+      }
+
+    std::list<Hit> hits;
+    bool ok = true;
+    std::vector<ApproximateHit> local;
+    for (const Shard &shard : this->shards_) {
+      std::uint64_t count = 0;
+      if (!ReadAll(shard.fd, &count, sizeof(count))) {
+        ok = false;
+        continue;
+      }
+      local.resize(count);
+      if (!ReadAll(shard.fd, local.data(), count * sizeof(ApproximateHit))) {
+        ok = false;
+        continue;
+      }
+      for (const ApproximateHit &hit : local)
+        hits.push_back({shard.begin + hit.position, hit.distance});
+    }
+    if (!ok) {
+      this->Stop();
+      return std::nullopt;
+    }
+    return hits;
+  }
+
+ private:
+  struct Shard {
+    std::size_t begin{};
+    std::size_t end{};
+    int fd{-1};
+    pid_t pid{-1};
+  };
+
+  struct Header {
+    std::uint32_t engine{};
+    std::int32_t max_errors{};
+    std::uint64_t pattern_size{};
+  };
+
+  std::string path_;
+  std::size_t max_query_size_;
+  std::vector<Shard> shards_;
+
+  bool Spawn(Shard &shard) {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) return false;
+    pid_t pid = ::fork();
+    if (pid < 0) {
+      ::close(fds[0]);
+      ::close(fds[1]);
+      return false;
+    }
+    if (pid == 0) {
+      ::close(fds[0]);
+      for (const Shard &other : this->shards_) ::close(other.fd);
+      try {
+        Serve(fds[1], this->path_, shard.begin, shard.end - shard.begin,
+              this->max_query_size_);
+      } catch (...) {
+        ::_exit(1);
+      }
+      ::_exit(0);
+    }
+    ::close(fds[1]);
+    shard.fd = fds[0];
+    shard.pid = pid;
+    return true;
+  }
+
+  void Stop() {
+    for (const Shard &shard : this->shards_) ::close(shard.fd);
+    for (const Shard &shard : this->shards_) ::waitpid(shard.pid, nullptr, 0);
+    this->shards_.clear();
+  }
+
+  static bool IsSingleThreaded() {
+    std::error_code error;
+    fs::directory_iterator tasks("/proc/self/task", error);
+    if (error) return true;
+    return std::distance(tasks, fs::directory_iterator()) <= 1;
+  }
+
+  static void Serve(int fd, std::string_view path, std::size_t begin,
+                    std::size_t owned, std::size_t max_query_size) {
+    MappedFile shard(path, begin, owned + max_query_size - 1);
+    if (!shard.IsOpen() && owned > 0) {
+      ::close(fd);
+      return;
+    }
+    std::string_view text = shard.View();
+    Header header;
+    std::string pattern;
+    std::vector<ApproximateHit> hits;
+    while (ReadAll(fd, &header, sizeof(header))) {
+      if (header.pattern_size > max_query_size) break;
+      pattern.resize(header.pattern_size);
+      if (!ReadAll(fd, pattern.data(), pattern.size())) break;
+
+      hits.clear();
+      const Engine engine = static_cast<Engine>(header.engine);
+      for (const ApproximateHit &hit :
+           Run(text, pattern, engine, header.max_errors))
+        if (static_cast<std::size_t>(hit.position) < owned)
+          hits.push_back(hit);
+      std::uint64_t count = hits.size();
+      if (!WriteAll(fd, &count, sizeof(count)) ||
+          !WriteAll(fd, hits.data(), count * sizeof(ApproximateHit)))
+        break;
+    }
+    ::close(fd);
+  }
+
+  static std::list<ApproximateHit> Run(std::string_view text,
+                                       std::string_view pattern, Engine engine,
+                                       int max_errors) {
+    std::list<ApproximateHit> hits;
+    switch (engine) {
+      case Engine::kExact:
+        for (int pos : RabinKarp::Search(text, pattern))
+          hits.push_back({pos, 0});
+        break;
+      case Engine::kIupac:
+        for (int pos : IupacSearch::Search(text, pattern, 1))
+          hits.push_back({pos, 0});
+        break;
+      case Engine::kMismatch:
+        hits = ApproximateSearch::Search(text, pattern, max_errors,
+                                         ApproximateSearch::Mode::kMismatch);
+        break;
+      case Engine::kEdit:
+        hits = ApproximateSearch::Search(text, pattern, max_errors,
+                                         ApproximateSearch::Mode::kEdit);
+        break;
+    }
+    return hits;
+  }
+
+  static bool WriteAll(int fd, const void *data, std::size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    while (size > 0) {
+      ssize_t written = ::send(fd, bytes, size, MSG_NOSIGNAL);
+      if (written < 0 && errno == EINTR) continue;
+      if (written <= 0) return false;
+      bytes += written;
+      size -= static_cast<std::size_t>(written);
+    }
+    return true;
+  }
+
+  static bool ReadAll(int fd, void *data, std::size_t size) {
+    char *bytes = static_cast<char *>(data);
+    while (size > 0) {
+      ssize_t received = ::recv(fd, bytes, size, 0);
+      if (received < 0 && errno == EINTR) continue;
+      if (received <= 0) return false;
+      bytes += received;
+      size -= static_cast<std::size_t>(received);
+    }
+    return true;
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_CONTROLLER_SHARD_COORDINATOR_HPP_
@@ -1,9 +1,56 @@
+#include <cstdlib>
+#include <exception>
 #include <iostream>
+#include <string>
+#include <string_view>
 
+#include "model/large_pages.hpp"
+#include "model/metrics.hpp"
 #include "view/console_view.hpp"
+#include "view/service_view.hpp"
 
-int main() {
-    s21::ConsoleView view;
-    view.RunApp();
+int main(int argc, char *argv[]) {
+    bool serve = false;
+    std::string_view metrics_format;
+    std::string_view shard_path;
+    std::size_t shard_workers = 0;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg(argv[i]);
+        if (arg == "--serve")
+            serve = true;
+        else if (arg.substr(0, 10) == "--metrics=")
+            metrics_format = arg.substr(10);
+        else if (arg.substr(0, 9) == "--shards=" && arg.find(':') != arg.npos) {
+            shard_workers = std::strtoul(argv[i] + 9, nullptr, 10);
+            shard_path = arg.substr(arg.find(':') + 1);
+        } else if (arg == "--numa=interleave")
+            s21::LargePages::SetDefaultPolicy({s21::LargePages::Numa::kInterleave, 0});
+        else if (arg.substr(0, 12) == "--numa=bind:")
+            s21::LargePages::SetDefaultPolicy(
+                {s21::LargePages::Numa::kBind, std::atoi(argv[i] + 12)});
+    }
+
+    if (serve) {
+        std::ios::sync_with_stdio(false);
+        s21::Controller controller;
+        if (!shard_path.empty()) {
+            try {
+                controller.StartShards(shard_path, shard_workers);
+            } catch (const std::exception &error) {
+                std::cerr << "shards: " << error.what() << std::endl;
+                return 1;
+            }
+        }
+        s21::ServiceView service(&controller);
+        service.RunService();
+    } else {
+        s21::ConsoleView view;
+        view.RunApp();
+    }
+
+    if (metrics_format == "json")
+        std::cerr << s21::Metrics::Instance().ToJson() << std::endl;
+    else if (metrics_format == "prom")
+        std::cerr << s21::Metrics::Instance().ToPrometheus();
     return 0;
 }
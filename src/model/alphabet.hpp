@@ -0,0 +1,123 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_ALPHABET_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_ALPHABET_HPP_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace s21 {
+using SymbolTable = std::array<std::uint8_t, 256>;
+
+template <typename Func>
+constexpr SymbolTable MakeSymbolTable(Func code) {
+  SymbolTable table{};
+  for (int symbol = 0; symbol < 256; symbol++)
+    table[symbol] = code(static_cast<char>(symbol));
+  return table;
+}
+
+constexpr char ToUpper(char symbol) {
+  return symbol >= 'a' && symbol <= 'z' ? symbol - 'a' + 'A' : symbol;
+}
+
+struct Dna5Alphabet {
+  static constexpr int kSize = 5;
+  static constexpr std::uint8_t kOther = 4;
+  static constexpr SymbolTable kCodes = MakeSymbolTable([](char symbol) {
+    switch (ToUpper(symbol)) {
+      case 'A':
+        return std::uint8_t{0};
+      case 'C':
+        return std::uint8_t{1};
+      case 'G':
+        return std::uint8_t{2};
+      case 'T':
+        return std::uint8_t{3};
+      default:
+        return kOther;
+    }
+  });
+
+  static constexpr std::uint8_t Code(char symbol) {
+    return kCodes[static_cast<unsigned char>(symbol)];
+  }
+
+  // N is the fifth symbol; any other byte shares its code, which only costs
+  // extra hash collisions that the scan rejects by comparison.
+  static constexpr bool Covers(std::string_view sequence) {
+    for (char symbol : sequence)
+      if (Code(symbol) == kOther && ToUpper(symbol) != 'N') return false;
+    return true;
+  }
+};
+
+struct IupacAlphabet {
+  static constexpr int kSize = 16;
+  static constexpr std::uint8_t kA = 1, kC = 2, kG = 4, kT = 8;
+  static constexpr SymbolTable kCodes = MakeSymbolTable([](char symbol) {
+    switch (ToUpper(symbol)) {
+      case 'A':
+        return kA;
+      case 'C':
+        return kC;
+      case 'G':
+        return kG;
+      case 'T':
+      case 'U':
+        return kT;
+      case 'R':
+        return std::uint8_t{kA | kG};
+      case 'Y':
+        return std::uint8_t{kC | kT};
+      case 'S':
+        return std::uint8_t{kC | kG};
+      case 'W':
+        return std::uint8_t{kA | kT};
+      case 'K':
+        return std::uint8_t{kG | kT};
+      case 'M':
+        return std::uint8_t{kA | kC};
+      case 'B':
+        return std::uint8_t{kC | kG | kT};
+      case 'D':
+        return std::uint8_t{kA | kG | kT};
+      case 'H':
+        return std::uint8_t{kA | kC | kT};
+      case 'V':
+        return std::uint8_t{kA | kC | kG};
+      case 'N':
+        return std::uint8_t{kA | kC | kG | kT};
+      default:
+        return std::uint8_t{0};
+    }
+  });
+
+  static constexpr std::uint8_t Code(char symbol) {
+    return kCodes[static_cast<unsigned char>(symbol)];
+  }
+
+  static constexpr bool Covers(std::string_view sequence) {
+    for (char symbol : sequence)
+      if (Code(symbol) == 0) return false;
+    return true;
+  }
+};
+
+struct ByteAlphabet {
+  static constexpr int kSize = 256;
+
+  static constexpr std::uint8_t Code(char symbol) {
+    return static_cast<unsigned char>(symbol);
+  }
+
+  static constexpr bool Covers(std::string_view) { return true; }
+};
+
+static_assert(Dna5Alphabet::Code('g') == 2 && Dna5Alphabet::Code('N') == 4);
+static_assert(Dna5Alphabet::Covers("ACGTNacgtn") &&
+              !Dna5Alphabet::Covers("ACGR"));
+static_assert(IupacAlphabet::Code('R') ==
+              (IupacAlphabet::kA | IupacAlphabet::kG));
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_ALPHABET_HPP_
@@ -0,0 +1,125 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_APPROXIMATE_SEARCH_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_APPROXIMATE_SEARCH_HPP_
+
+#include <algorithm>
+#include <limits>
+#include <list>
+#include <string_view>
+#include <vector>
+
+#include "arena.hpp"
+#include "dna_search.hpp"
+#include "metrics.hpp"
+
+namespace s21 {
+struct ApproximateHit {
+  int position{};
+  int distance{};
+
+  bool operator==(const ApproximateHit &other) const noexcept {
+    return position == other.position && distance == other.distance;
+  }
+};
+
+class ApproximateSearch {
+ public:
+  enum class Mode { kMismatch, kEdit };
+
+  static std::list<ApproximateHit> Search(std::string_view text,
+                                          std::string_view pattern,
+                                          int max_errors,
+                                          Mode mode = Mode::kMismatch,
+                                          Arena *arena = nullptr) {
+    S21_METRICS_TIMER("dna_approx_search_ns");
+    std::list<ApproximateHit> hits;
+    const int text_size = static_cast<int>(text.size());
+    const int pattern_size = static_cast<int>(pattern.size());
+    if (text.empty() || pattern.empty() || max_errors < 0) return hits;
+    if (text_size < pattern_size - (mode == Mode::kEdit ? max_errors : 0))
+      return hits;
+    if (arena == nullptr) arena = &Arena::ThreadLocal();
+    Arena::Scope scope(*arena);
+
+    const int slack = mode == Mode::kEdit ? max_errors : 0;
+    const int last_start = std::min(
+        text_size - std::max(pattern_size - slack, 0), text_size - 1);
+
+    std::vector<int> candidates;
+    if (max_errors >= pattern_size) {
+      for (int start = 0; start <= last_start; start++)
+        candidates.push_back(start);
+    } else {
+      const int seeds = max_errors + 1;
+      for (int seed = 0; seed < seeds; seed++) {
+        int begin = seed * pattern_size / seeds;
+        int end = (seed + 1) * pattern_size / seeds;
+        for (int pos : RabinKarp::Search(
+                 text, pattern.substr(begin, end - begin))) {
+          int first = std::max(pos - begin - slack, 0);
+          int last = std::min(pos - begin + slack, last_start);
+          for (int start = first; start <= last; start++)
+            candidates.push_back(start);
+        }
+      }
+      std::sort(candidates.begin(), candidates.end());
+      candidates.erase(std::unique(candidates.begin(), candidates.end()),
+                       candidates.end());
+    }
+    S21_METRICS_COUNT("dna_approx_candidates_total", candidates.size());
+
+    for (int start : candidates) {
+      int distance =
+          mode == Mode::kMismatch
+              ? CountMismatches(text.substr(start), pattern, max_errors)
+              : BandedEditDistance(text.substr(start), pattern, max_errors,
+                                   *arena);
+      if (distance <= max_errors) hits.push_back({start, distance});
+    }
+    return hits;
+  }
+
+ private:
+  static int CountMismatches(std::string_view text, std::string_view pattern,
+                             int max_errors) noexcept {
+    int mismatches = 0;
+    for (std::size_t i = 0; i < pattern.size(); i++)
+      if (text[i] != pattern[i] && ++mismatches > max_errors) break;
+    return mismatches;
+  }
+
+  static int BandedEditDistance(std::string_view text,
+                                std::string_view pattern, int band,
+                                Arena &arena) {
+    Arena::Scope scope(arena);
+    const int inf = std::numeric_limits<int>::max() / 2;
+    const int rows = static_cast<int>(pattern.size());
+    const int cols = std::min(static_cast<int>(text.size()), rows + band);
+    int *prev = arena.AllocateZeroed<int>(cols + 1);
+    int *row = arena.AllocateZeroed<int>(cols + 1);
+
+    for (int j = 0; j <= cols; j++) prev[j] = j <= band ? j : inf;
+    for (int i = 1; i <= rows; i++) {
+      const int first = std::max(i - band, 0);
+      const int last = std::min(i + band, cols);
+      int row_min = inf;
+      if (first == 0) row_min = row[0] = i;
+      if (first > 0) row[first - 1] = inf;
+      if (last < cols) row[last + 1] = inf;
+      for (int j = std::max(first, 1); j <= last; j++) {
+        int cost = pattern[i - 1] == text[j - 1] ? 0 : 1;
+        row[j] = std::min({prev[j - 1] + cost, prev[j] + 1, row[j - 1] + 1});
+        row_min = std::min(row_min, row[j]);
+      }
+      if (row_min > band) return band + 1;
+      std::swap(prev, row);
+    }
+
+    int best = inf;
+    for (int j = std::max(rows - band, 0); j <= cols; j++)
+      best = std::min(best, prev[j]);
+    return best;
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_APPROXIMATE_SEARCH_HPP_
@@ -0,0 +1,129 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_ARENA_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_ARENA_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "large_pages.hpp"
+
+namespace s21 {
+class Arena {
+ public:
+  class Scope {
+   public:
+    explicit Scope(Arena &arena) noexcept
+        : arena_(arena), block_(arena.block_), offset_(arena.offset_) {
+      arena.depth_++;
+    }
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+    ~Scope() {
+      this->arena_.block_ = this->block_;
+      this->arena_.offset_ = this->offset_;
+      if (--this->arena_.depth_ == 0 && this->block_ == 0 &&
+          this->offset_ == 0)
+        this->arena_.Trim();
+    }
+
+   private:
+    Arena &arena_;
+    std::size_t block_;
+    std::size_t offset_;
+  };
+
+  static constexpr std::size_t kDefaultBlockSize = 1 << 16;
+
+  explicit Arena(std::size_t block_size = kDefaultBlockSize) noexcept
+      : block_size_(block_size) {}
+  Arena(const Arena &) = delete;
+  Arena &operator=(const Arena &) = delete;
+  ~Arena() = default;
+
+  static Arena &ThreadLocal() {
+    static thread_local Arena arena;
+    return arena;
+  }
+
+  template <typename T>
+  T *Allocate(std::size_t count, std::size_t alignment = alignof(T)) {
+    static_assert(std::is_trivially_destructible_v<T>,
+                  "Arena memory is released without calling destructors");
+    return static_cast<T *>(this->AllocateBytes(
+        count * sizeof(T), std::max(alignment, alignof(T))));
+  }
+
+  template <typename T>
+  T *AllocateZeroed(std::size_t count, std::size_t alignment = alignof(T)) {
+    T *data = this->Allocate<T>(count, alignment);
+    std::fill_n(data, count, T{});
+    return data;
+  }
+
+  void Reset() noexcept {
+    this->block_ = 0;
+    this->offset_ = 0;
+    this->Trim();
+  }
+
+  // Keeps only the largest block; call it only when nothing is allocated.
+  void Trim() noexcept {
+    if (this->blocks_.size() < 2) return;
+    auto largest = std::max_element(
+        this->blocks_.begin(), this->blocks_.end(),
+        [](const Block &a, const Block &b) { return a.size < b.size; });
+    std::swap(*largest, this->blocks_.front());
+    this->blocks_.resize(1);
+  }
+
+  std::size_t Capacity() const noexcept {
+    std::size_t capacity = 0;
+    for (const auto &block : this->blocks_) capacity += block.size;
+    return capacity;
+  }
+
+ private:
+  struct Block {
+    std::unique_ptr<std::byte[], LargePages::Deleter> data;
+    std::size_t size{};
+  };
+
+  std::size_t block_size_;
+  std::size_t block_{};
+  std::size_t offset_{};
+  std::size_t depth_{};
+  std::vector<Block> blocks_;
+
+  void *AllocateBytes(std::size_t bytes, std::size_t alignment) {
+    for (; this->block_ < this->blocks_.size(); this->block_++) {
+      void *data = this->TryAllocate(bytes, alignment);
+      if (data != nullptr) return data;
+      this->offset_ = 0;
+    }
+    std::size_t size = std::max(this->block_size_, bytes + alignment);
+    std::unique_ptr<std::byte[], LargePages::Deleter> data(
+        static_cast<std::byte *>(LargePages::Allocate(size)),
+        LargePages::Deleter(size));
+    this->blocks_.push_back({std::move(data), size});
+    this->block_ = this->blocks_.size() - 1;
+    this->offset_ = 0;
+    return this->TryAllocate(bytes, alignment);
+  }
+
+  void *TryAllocate(std::size_t bytes, std::size_t alignment) noexcept {
+    Block &block = this->blocks_[this->block_];
+    auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+    std::uintptr_t begin = base + this->offset_;
+    begin = (begin + alignment - 1) / alignment * alignment;
+    if (begin + bytes > base + block.size) return nullptr;
+    this->offset_ = begin + bytes - base;
+    return reinterpret_cast<void *>(begin);
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_ARENA_HPP_
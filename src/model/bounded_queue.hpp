@@ -0,0 +1,84 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_BOUNDED_QUEUE_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_BOUNDED_QUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace s21 {
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+    this->mask_ = size - 1;
+    this->cells_ = std::make_unique<Cell[]>(size);
+    for (std::size_t i = 0; i < size; i++)
+      this->cells_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+  ~BoundedQueue() = default;
+
+  bool TryPush(T &&value) {
+    std::size_t pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = this->cells_[pos & this->mask_];
+      std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                  static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (this->enqueue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = this->enqueue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool TryPop(T &value) {
+    std::size_t pos = this->dequeue_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Cell &cell = this->cells_[pos & this->mask_];
+      std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      auto diff = static_cast<std::ptrdiff_t>(sequence) -
+                  static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (this->dequeue_pos_.compare_exchange_weak(
+                pos, pos + 1, std::memory_order_relaxed)) {
+          value = std::move(cell.value);
+          cell.sequence.store(pos + this->mask_ + 1,
+                              std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = this->dequeue_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+ private:
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> cells_;
+  std::size_t mask_{};
+  alignas(64) std::atomic<std::size_t> enqueue_pos_{};
+  alignas(64) std::atomic<std::size_t> dequeue_pos_{};
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_BOUNDED_QUEUE_HPP_
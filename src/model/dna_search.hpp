@@ -1,23 +1,58 @@
 #ifndef A7_DNA_ANALYZER_1_1_MODEL_RK_ALGORITHM_HPP_
 #define A7_DNA_ANALYZER_1_1_MODEL_RK_ALGORITHM_HPP_
 
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <ios>
+#include <limits>
 #include <list>
+#include <map>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "alphabet.hpp"
+#include "large_pages.hpp"
+#include "metrics.hpp"
+#include "prefetch_reader.hpp"
+#include "thread_pool.hpp"
 
 namespace fs = std::filesystem;
 
 namespace s21 {
+enum class Strand { kForward, kReverse };
+
+struct StrandHit {
+  int position{};
+  Strand strand{};
+
+  bool operator==(const StrandHit &other) const noexcept {
+    return position == other.position && strand == other.strand;
+  }
+};
+
 class RabinKarp {
  public:
+  enum class QueryMode { kExists, kCount, kFirstN };
+
+  struct QueryResult {
+    std::size_t count{};
+    std::list<int> positions;
+  };
+
   RabinKarp() = default;
   ~RabinKarp() = default;
 
   void SetText(std::string_view text) {
+    this->text_.clear();
+    this->text_path_.clear();
     if (fs::exists(text))
-      this->text_ = ReadFile(text);
+      this->text_path_ = text;
     else
       this->text_ = text;
   }
@@ -29,76 +64,377 @@ class RabinKarp {
       this->pattern_ = pattern;
   }
 
-  std::list<int> GetPositions() const { return this->Search(); }
+  std::list<int> GetPositions() const {
+    if (!this->text_path_.empty())
+      return SearchFile(this->text_path_, this->pattern_);
+    return Search(this->text_, this->pattern_);
+  }
+
+  std::list<StrandHit> GetStrandPositions() const {
+    if (!this->text_path_.empty())
+      return SearchFileBothStrands(this->text_path_, this->pattern_);
+    return SearchBothStrands(this->text_, this->pattern_);
+  }
+
+  bool Exists() const { return this->Query(QueryMode::kExists).count > 0; }
+  std::size_t Count() const { return this->Query(QueryMode::kCount).count; }
+  std::list<int> FirstN(std::size_t n) const {
+    return this->Query(QueryMode::kFirstN, n).positions;
+  }
+
+  QueryResult Query(QueryMode mode, std::size_t n = 0) const {
+    if (!this->text_path_.empty())
+      return QueryFile(this->text_path_, this->pattern_, mode, n);
+    return Query(this->text_, this->pattern_, mode, n);
+  }
+
+  static std::string ReverseComplement(std::string_view sequence) {
+    std::string result(sequence.rbegin(), sequence.rend());
+    for (char &symbol : result) symbol = Complement(symbol);
+    return result;
+  }
+
+  static std::list<int> Search(std::string_view text,
+                               std::string_view pattern) {
+    S21_METRICS_TIMER("dna_rk_search_ns");
+    std::list<int> positions;
+    Scan(text, pattern, {},
+         [&positions](std::size_t pos, Strand) { positions.push_back(pos); });
+    S21_METRICS_COUNT("dna_rk_hits_total", positions.size());
+    return positions;
+  }
+
+  static std::list<StrandHit> SearchBothStrands(std::string_view text,
+                                                std::string_view pattern) {
+    S21_METRICS_TIMER("dna_rk_search_ns");
+    std::list<StrandHit> hits;
+    const std::string reverse = ReverseComplement(pattern);
+    Scan(text, pattern, reverse, [&hits](std::size_t pos, Strand strand) {
+      hits.push_back({static_cast<int>(pos), strand});
+    });
+    S21_METRICS_COUNT("dna_rk_hits_total", hits.size());
+    return hits;
+  }
+
+  static std::list<int> SearchFile(
+      std::string_view path, std::string_view pattern,
+      std::size_t threads = ThreadPool::DefaultThreads(),
+      std::size_t chunk_size = PrefetchReader::kDefaultChunkSize) {
+    return SearchChunks<int>(
+        path, pattern.size(), threads, chunk_size,
+        [pattern](std::string_view chunk) { return Search(chunk, pattern); });
+  }
+
+  static std::list<StrandHit> SearchFileBothStrands(
+      std::string_view path, std::string_view pattern,
+      std::size_t threads = ThreadPool::DefaultThreads(),
+      std::size_t chunk_size = PrefetchReader::kDefaultChunkSize) {
+    return SearchChunks<StrandHit>(
+        path, pattern.size(), threads, chunk_size,
+        [pattern](std::string_view chunk) {
+          return SearchBothStrands(chunk, pattern);
+        });
+  }
+
+  static bool Exists(std::string_view text, std::string_view pattern,
+                     std::size_t threads = ThreadPool::DefaultThreads()) {
+    return Query(text, pattern, QueryMode::kExists, 0, threads).count > 0;
+  }
+
+  static std::size_t Count(
+      std::string_view text, std::string_view pattern,
+      std::size_t threads = ThreadPool::DefaultThreads()) {
+    return Query(text, pattern, QueryMode::kCount, 0, threads).count;
+  }
+
+  static std::list<int> FirstN(
+      std::string_view text, std::string_view pattern, std::size_t n,
+      std::size_t threads = ThreadPool::DefaultThreads()) {
+    return Query(text, pattern, QueryMode::kFirstN, n, threads).positions;
+  }
+
+  static QueryResult Query(
+      std::string_view text, std::string_view pattern, QueryMode mode,
+      std::size_t n = 0, std::size_t threads = ThreadPool::DefaultThreads()) {
+    S21_METRICS_TIMER("dna_rk_query_ns");
+    QueryState state(mode, n);
+    const std::size_t pattern_size = pattern.size();
+    if (pattern.empty() || pattern_size > text.size() || state.limit == 0)
+      return {};
+    const std::size_t windows = text.size() - pattern_size + 1;
+    threads = std::clamp<std::size_t>(
+        threads, 1, std::max<std::size_t>(windows / kMinRange, 1));
+
+    std::vector<QueryResult> parts(threads);
+    RunInThreads(threads, [&](std::size_t t) {
+      std::size_t begin = windows * t / threads;
+      std::size_t end = windows * (t + 1) / threads;
+      QueryChunk(text.substr(begin, end - begin + pattern_size - 1), pattern,
+                 begin, t, state, parts[t]);
+    });
+    return state.Merge(parts);
+  }
+
+  static QueryResult QueryFile(
+      std::string_view path, std::string_view pattern, QueryMode mode,
+      std::size_t n = 0, std::size_t threads = ThreadPool::DefaultThreads(),
+      std::size_t chunk_size = PrefetchReader::kDefaultChunkSize) {
+    S21_METRICS_TIMER("dna_rk_query_ns");
+    QueryState state(mode, n);
+    const std::size_t pattern_size = pattern.size();
+    if (pattern.empty() || state.limit == 0) return {};
+    if (threads == 0) threads = 1;
+
+    PrefetchReader reader(path, pattern_size - 1, chunk_size, threads + 2);
+    std::mutex mutex;
+    std::map<std::size_t, QueryResult> found;
+    RunInThreads(threads, [&](std::size_t) {
+      PrefetchReader::Chunk chunk;
+      while (!state.Cancelled(0) && reader.Next(chunk)) {
+        if (state.Cancelled(chunk.offset)) break;
+        QueryResult local;
+        std::string_view data = chunk.data;
+        QueryChunk(data.substr(0, chunk.owned + pattern_size - 1), pattern,
+                   chunk.offset, chunk.offset, state, local);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          found[chunk.offset] = std::move(local);
+        }
+        reader.Release(std::move(chunk));
+      }
+    });
+
+    if (reader.HasError()) ThrowReadError(path);
+    std::vector<QueryResult> parts;
+    for (auto &[offset, local] : found) parts.push_back(std::move(local));
+    return state.Merge(parts);
+  }
 
  private:
-  std::string text_;
+  static constexpr std::size_t kMinRange = 1 << 16;
+  static constexpr std::size_t kCancelStride = 1 << 12;
+
+  struct QueryState {
+    std::size_t limit;
+    bool ordered;
+    std::atomic<bool> done{};
+    std::atomic<std::size_t> cutoff{std::numeric_limits<std::size_t>::max()};
+
+    QueryState(QueryMode mode, std::size_t n)
+        : limit(mode == QueryMode::kExists  ? 1
+                : mode == QueryMode::kFirstN ? n
+                                             : std::numeric_limits<
+                                                   std::size_t>::max()),
+          ordered(mode == QueryMode::kFirstN) {}
+
+    bool Cancelled(std::size_t key) const noexcept {
+      return this->done.load(std::memory_order_relaxed) ||
+             this->cutoff.load(std::memory_order_relaxed) < key;
+    }
+
+    void Reached(std::size_t key) noexcept {
+      if (!this->ordered) {
+        this->done.store(true, std::memory_order_relaxed);
+        return;
+      }
+      std::size_t current = this->cutoff.load(std::memory_order_relaxed);
+      while (key < current &&
+             !this->cutoff.compare_exchange_weak(current, key,
+                                                 std::memory_order_relaxed)) {
+      }
+    }
+
+    QueryResult Merge(std::vector<QueryResult> &parts) const {
+      QueryResult result;
+      for (QueryResult &part : parts) {
+        result.count += part.count;
+        result.positions.splice(result.positions.end(), part.positions);
+      }
+      if (result.positions.size() > this->limit)
+        result.positions.resize(this->limit);
+      result.count = this->ordered ? result.positions.size()
+                                   : std::min(result.count, this->limit);
+      return result;
+    }
+  };
+
+  LargeString text_;
+  std::string text_path_;
   std::string pattern_;
 
-  bool CompareStrings(std::size_t pos) const noexcept {
-    const std::size_t pattern_size = this->pattern_.size();
-    for (std::size_t j = 0; j < pattern_size; ++j)
-      if (this->text_[pos + j] != this->pattern_[j]) return false;
-    return true;
+  static void QueryChunk(std::string_view chunk, std::string_view pattern,
+                         std::size_t offset, std::size_t key,
+                         QueryState &state, QueryResult &result) {
+    Scan(
+        chunk, pattern, {},
+        [&](std::size_t pos, Strand) {
+          if (state.ordered)
+            result.positions.push_back(static_cast<int>(offset + pos));
+          if (++result.count < state.limit) return true;
+          state.Reached(key);
+          return false;
+        },
+        [&]() { return state.Cancelled(key); });
+    S21_METRICS_COUNT("dna_rk_hits_total", result.count);
   }
 
-  std::string ReadFile(std::string_view path) const {
-    std::string result;
-    std::ifstream file(fs::path(path), std::ios::binary | std::ios::in);
-    if (file.is_open()) {
-      file.seekg(0, std::ios::end);
-      int file_size = file.tellg();
-      file.seekg(0, std::ios::beg);
-      char *buffer = new char[file_size]{};
-      file.read(buffer, file_size);
-      for (int i = 0; i < file_size; i++) result += buffer[i];
-      delete buffer;
+  static char Complement(char symbol) noexcept {
+    constexpr std::string_view from = "ACGTacgt";
+    constexpr std::string_view to = "TGCAtgca";
+    std::size_t index = from.find(symbol);
+    return index == std::string_view::npos ? symbol : to[index];
+  }
+
+  static int &PositionOf(int &pos) noexcept { return pos; }
+  static int &PositionOf(StrandHit &hit) noexcept { return hit.position; }
+
+  template <typename OnHit>
+  static bool Emit(OnHit &on_hit, std::size_t pos, Strand strand) {
+    if constexpr (std::is_void_v<
+                      std::invoke_result_t<OnHit &, std::size_t, Strand>>) {
+      on_hit(pos, strand);
+      return true;
+    } else {
+      return on_hit(pos, strand);
     }
-    file.close();
-    return result;
   }
 
-  std::list<int> Search() const {
-    std::list<int> positions;
+  template <typename OnHit, typename Stop = bool (*)()>
+  static void Scan(
+      std::string_view text, std::string_view pattern,
+      std::string_view reverse, OnHit on_hit,
+      Stop stop = []() { return false; }) {
+    if (Dna5Alphabet::Covers(pattern))
+      ScanWith<Dna5Alphabet>(text, pattern, reverse, on_hit, stop);
+    else
+      ScanWith<ByteAlphabet>(text, pattern, reverse, on_hit, stop);
+  }
 
-    if (pattern_.size() > text_.size()) return positions;
+  template <typename Alphabet, typename OnHit, typename Stop>
+  static void ScanWith(std::string_view text, std::string_view pattern,
+                       std::string_view reverse, OnHit &on_hit, Stop &stop) {
+    if (pattern.empty() || pattern.size() > text.size()) return;
 
     const int mod = 9973;
-    const int abc_size = 256;
+    constexpr int abc_size = Alphabet::kSize;
 
     int first_symbol_hash = 1;
-    int substring_hash = static_cast<int>(this->text_[0]) % mod;
-    int pattern_hash = static_cast<int>(this->pattern_[0]) % mod;
+    int substring_hash = Alphabet::Code(text[0]) % mod;
+    int pattern_hash = Alphabet::Code(pattern[0]) % mod;
+    int reverse_hash = 0;
+    if (!reverse.empty()) reverse_hash = Alphabet::Code(reverse[0]) % mod;
 
-    std::size_t pattern_size = this->pattern_.size();
-    for (std::size_t i = 1; i < pattern_size; i++) {
-      pattern_hash *= abc_size;
-      pattern_hash += static_cast<int>(this->pattern_[i]);
-      pattern_hash %= mod;
+    std::size_t pattern_size = pattern.size();
+    {
+      S21_METRICS_TIMER("dna_rk_preprocess_ns");
+      for (std::size_t i = 1; i < pattern_size; i++) {
+        pattern_hash *= abc_size;
+        pattern_hash += Alphabet::Code(pattern[i]);
+        pattern_hash %= mod;
 
-      substring_hash *= abc_size;
-      substring_hash += static_cast<int>(this->text_[i]);
-      substring_hash %= mod;
+        if (!reverse.empty()) {
+          reverse_hash *= abc_size;
+          reverse_hash += Alphabet::Code(reverse[i]);
+          reverse_hash %= mod;
+        }
 
-      first_symbol_hash *= abc_size;
-      first_symbol_hash %= mod;
+        substring_hash *= abc_size;
+        substring_hash += Alphabet::Code(text[i]);
+        substring_hash %= mod;
+
+        first_symbol_hash *= abc_size;
+        first_symbol_hash %= mod;
+      }
     }
 
-    std::size_t text_size = this->text_.size();
+    std::size_t text_size = text.size();
     std::size_t size_offset = text_size - pattern_size;
     for (std::size_t pos = 0; pos <= size_offset; pos++) {
-      if (pattern_hash == substring_hash && CompareStrings(pos))
-        positions.push_back(pos);
+      if (pos % kCancelStride == 0 && stop()) return;
+      if (pattern_hash == substring_hash) {
+        if (!CompareStrings(text, pattern, pos))
+          S21_METRICS_COUNT("dna_rk_hash_collisions_total", 1);
+        else if (!Emit(on_hit, pos, Strand::kForward))
+          return;
+      }
+      if (!reverse.empty() && reverse_hash == substring_hash) {
+        if (!CompareStrings(text, reverse, pos))
+          S21_METRICS_COUNT("dna_rk_hash_collisions_total", 1);
+        else if (!Emit(on_hit, pos, Strand::kReverse))
+          return;
+      }
       if (pos == size_offset) break;
 
-      substring_hash -=
-          (static_cast<int>(this->text_[pos]) * first_symbol_hash) % mod;
+      substring_hash -= (Alphabet::Code(text[pos]) * first_symbol_hash) % mod;
       substring_hash += mod;
       substring_hash *= abc_size;
-      substring_hash += static_cast<int>(this->text_[pos + pattern_size]);
+      substring_hash += Alphabet::Code(text[pos + pattern_size]);
       substring_hash %= mod;
     }
-    return positions;
+    S21_METRICS_COUNT("dna_rk_windows_total", size_offset + 1);
+  }
+
+  template <typename Hit, typename SearchFunc>
+  static std::list<Hit> SearchChunks(std::string_view path,
+                                     std::size_t pattern_size,
+                                     std::size_t threads,
+                                     std::size_t chunk_size,
+                                     SearchFunc search) {
+    std::list<Hit> hits;
+    if (pattern_size == 0) return hits;
+    if (threads == 0) threads = 1;
+
+    PrefetchReader reader(path, pattern_size - 1, chunk_size, threads + 2);
+    std::mutex mutex;
+    std::map<std::size_t, std::list<Hit>> found;
+    auto work = [&]() {
+      PrefetchReader::Chunk chunk;
+      while (reader.Next(chunk)) {
+        std::list<Hit> local = search(chunk.data);
+        const std::size_t owned = chunk.owned;
+        local.remove_if([owned](Hit &hit) {
+          return static_cast<std::size_t>(PositionOf(hit)) >= owned;
+        });
+        for (Hit &hit : local) PositionOf(hit) += chunk.offset;
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          found[chunk.offset] = std::move(local);
+        }
+        reader.Release(std::move(chunk));
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; i++) workers.emplace_back(work);
+    work();
+    for (auto &worker : workers) worker.join();
+
+    if (reader.HasError()) ThrowReadError(path);
+    for (auto &[offset, local] : found) hits.splice(hits.end(), local);
+    return hits;
+  }
+
+  [[noreturn]] static void ThrowReadError(std::string_view path) {
+    throw std::ios_base::failure("failed to read " + std::string(path));
+  }
+
+  static bool CompareStrings(std::string_view text, std::string_view pattern,
+                             std::size_t pos) noexcept {
+    return text.compare(pos, pattern.size(), pattern) == 0;
+  }
+
+  std::string ReadFile(std::string_view path) const {
+    S21_METRICS_TIMER("dna_rk_load_ns");
+    std::string result;
+    std::ifstream file(fs::path(path), std::ios::binary | std::ios::in);
+    if (file.is_open()) {
+      file.seekg(0, std::ios::end);
+      result.resize(static_cast<std::size_t>(file.tellg()));
+      file.seekg(0, std::ios::beg);
+      file.read(result.data(), result.size());
+    }
+    file.close();
+    return result;
   }
 };
 }  // namespace s21
@@ -0,0 +1,95 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_INCREMENTAL_SEARCH_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_INCREMENTAL_SEARCH_HPP_
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dna_search.hpp"
+#include "large_pages.hpp"
+#include "metrics.hpp"
+
+namespace s21 {
+class IncrementalSearch {
+ public:
+  IncrementalSearch() = default;
+  IncrementalSearch(std::string_view text, std::string_view pattern)
+      : text_(text), pattern_(pattern) {
+    this->Scan(0, this->text_.size(), this->positions_);
+  }
+  ~IncrementalSearch() = default;
+
+  std::string_view Text() const noexcept { return this->text_; }
+  std::string_view Pattern() const noexcept { return this->pattern_; }
+  const std::vector<std::size_t> &Positions() const noexcept {
+    return this->positions_;
+  }
+
+  void Replace(std::size_t pos, std::size_t count,
+               std::string_view replacement) {
+    S21_METRICS_TIMER("dna_rk_incremental_edit_ns");
+    pos = std::min(pos, this->text_.size());
+    count = std::min(count, this->text_.size() - pos);
+    const std::size_t pattern_size = this->pattern_.size();
+    this->text_.replace(pos, count, replacement);
+    if (pattern_size == 0) return;
+
+    const std::size_t first = pos >= pattern_size ? pos - pattern_size + 1 : 0;
+    auto &positions = this->positions_;
+    auto begin = std::lower_bound(positions.begin(), positions.end(), first);
+    auto end = std::lower_bound(begin, positions.end(), pos + count);
+    if (replacement.size() > count) {
+      const std::size_t grow = replacement.size() - count;
+      for (auto it = end; it != positions.end(); ++it) *it += grow;
+    } else if (replacement.size() < count) {
+      const std::size_t shrink = count - replacement.size();
+      for (auto it = end; it != positions.end(); ++it) *it -= shrink;
+    }
+
+    const std::size_t last = std::min(
+        pos + replacement.size() + pattern_size - 1, this->text_.size());
+    std::vector<std::size_t> found;
+    this->Scan(first, last, found);
+    S21_METRICS_COUNT("dna_rk_incremental_windows_total",
+                      last > first ? last - first : 0);
+
+    auto index = begin - positions.begin();
+    positions.erase(begin, end);
+    positions.insert(positions.begin() + index, found.begin(), found.end());
+  }
+
+  void Insert(std::size_t pos, std::string_view sequence) {
+    this->Replace(pos, 0, sequence);
+  }
+
+  void Erase(std::size_t pos, std::size_t count) {
+    this->Replace(pos, count, {});
+  }
+
+ private:
+  // RabinKarp reports int offsets, so long ranges are searched in
+  // overlapping chunks that each stay well below INT_MAX.
+  static constexpr std::size_t kChunk = std::size_t{1} << 30;
+
+  LargeString text_;
+  std::string pattern_;
+  std::vector<std::size_t> positions_;
+
+  void Scan(std::size_t first, std::size_t last,
+            std::vector<std::size_t> &found) const {
+    const std::size_t pattern_size = this->pattern_.size();
+    if (pattern_size == 0) return;
+    std::string_view text(this->text_);
+    for (std::size_t begin = first; begin + pattern_size <= last;
+         begin += kChunk) {
+      std::size_t end = std::min(begin + kChunk + pattern_size - 1, last);
+      for (int hit : RabinKarp::Search(text.substr(begin, end - begin),
+                                       this->pattern_))
+        found.push_back(begin + static_cast<std::size_t>(hit));
+    }
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_INCREMENTAL_SEARCH_HPP_
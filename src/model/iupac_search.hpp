@@ -0,0 +1,108 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_IUPAC_SEARCH_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_IUPAC_SEARCH_HPP_
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <string_view>
+#include <vector>
+
+#include "alphabet.hpp"
+#include "metrics.hpp"
+#include "thread_pool.hpp"
+
+namespace s21 {
+class IupacSearch {
+ public:
+  IupacSearch() = default;
+  explicit IupacSearch(std::string_view pattern)
+      : size_(pattern.size()),
+        words_((pattern.size() + 63) / 64),
+        masks_(256 * words_) {
+    for (int symbol = 0; symbol < 256; symbol++) {
+      const std::uint8_t code = IupacAlphabet::Code(static_cast<char>(symbol));
+      std::uint64_t *row = &this->masks_[symbol * this->words_];
+      for (std::size_t j = 0; j < pattern.size(); j++)
+        if ((IupacAlphabet::Code(pattern[j]) & code) != 0)
+          row[j / 64] |= std::uint64_t{1} << (j % 64);
+    }
+  }
+  ~IupacSearch() = default;
+
+  std::size_t Size() const noexcept { return this->size_; }
+
+  static std::list<int> Search(
+      std::string_view text, std::string_view pattern,
+      std::size_t threads = ThreadPool::DefaultThreads()) {
+    return IupacSearch(pattern).Find(text, threads);
+  }
+
+  std::list<int> Find(
+      std::string_view text,
+      std::size_t threads = ThreadPool::DefaultThreads()) const {
+    S21_METRICS_TIMER("dna_iupac_search_ns");
+    std::list<int> positions;
+    if (this->size_ == 0 || this->size_ > text.size()) return positions;
+    const std::size_t windows = text.size() - this->size_ + 1;
+    threads = std::clamp<std::size_t>(
+        threads, 1, std::max<std::size_t>(windows / kMinRange, 1));
+
+    std::vector<std::list<int>> parts(threads);
+    RunInThreads(threads, [&](std::size_t t) {
+      std::size_t begin = windows * t / threads;
+      std::size_t end = windows * (t + 1) / threads;
+      std::string_view chunk =
+          text.substr(begin, end - begin + this->size_ - 1);
+      auto on_hit = [&](std::size_t pos) {
+        parts[t].push_back(static_cast<int>(begin + pos));
+      };
+      if (this->words_ == 1)
+        this->ScanWord(chunk, on_hit);
+      else
+        this->ScanWords(chunk, on_hit);
+    });
+    for (auto &part : parts) positions.splice(positions.end(), part);
+    S21_METRICS_COUNT("dna_iupac_hits_total", positions.size());
+    return positions;
+  }
+
+ private:
+  static constexpr std::size_t kMinRange = 1 << 16;
+
+  std::size_t size_{};
+  std::size_t words_{};
+  std::vector<std::uint64_t> masks_;
+
+  template <typename OnHit>
+  void ScanWord(std::string_view text, OnHit &on_hit) const {
+    const std::uint64_t *masks = this->masks_.data();
+    const std::uint64_t last = std::uint64_t{1} << (this->size_ - 1);
+    std::uint64_t state = 0;
+    for (std::size_t i = 0; i < text.size(); i++) {
+      state = ((state << 1) | 1) & masks[static_cast<unsigned char>(text[i])];
+      if (state & last) on_hit(i + 1 - this->size_);
+    }
+  }
+
+  template <typename OnHit>
+  void ScanWords(std::string_view text, OnHit &on_hit) const {
+    const std::size_t words = this->words_;
+    const std::size_t top = (this->size_ - 1) / 64;
+    const std::uint64_t last = std::uint64_t{1} << ((this->size_ - 1) % 64);
+    std::vector<std::uint64_t> state(words);
+    for (std::size_t i = 0; i < text.size(); i++) {
+      const std::uint64_t *row =
+          &this->masks_[static_cast<unsigned char>(text[i]) * words];
+      std::uint64_t carry = 1;
+      for (std::size_t w = 0; w < words; w++) {
+        std::uint64_t next = state[w] >> 63;
+        state[w] = ((state[w] << 1) | carry) & row[w];
+        carry = next;
+      }
+      if (state[top] & last) on_hit(i + 1 - this->size_);
+    }
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_IUPAC_SEARCH_HPP_
@@ -1,17 +1,25 @@
 #ifndef A7_DNA_ANALYZER_1_1_MODEL_K_STRINGS_HPP_
 #define A7_DNA_ANALYZER_1_1_MODEL_K_STRINGS_HPP_
 
+#include <algorithm>
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "metrics.hpp"
+#include "thread_pool.hpp"
+
 namespace fs = std::filesystem;
 
 namespace s21 {
 class KString {
  public:
+  using StringPair = std::pair<std::string_view, std::string_view>;
+
   KString() = default;
   ~KString() = default;
 
@@ -26,32 +34,46 @@ class KString {
     file.close();
   }
 
-  int GetDiffCount() const {
-    if (!this->IsAnagrams()) return -1;
+  int GetDiffCount() const { return GetDiffCount(this->str_a_, this->str_b_); }
+
+  static int GetDiffCount(std::string_view str_a, std::string_view str_b) {
+    S21_METRICS_TIMER("dna_ks_similarity_ns");
+    if (!IsAnagrams(str_a, str_b)) return -1;
 
-    return KSimilarity(this->str_a_, this->str_b_);
+    return KSimilarity(str_a, str_b);
+  }
+
+  static void GetDiffCounts(
+      const StringPair *pairs, std::size_t count, int *results,
+      std::size_t threads = ThreadPool::DefaultThreads()) {
+    ForEachRange(count, threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++)
+        results[i] = GetDiffCount(pairs[i].first, pairs[i].second);
+    });
   }
 
  private:
   std::string str_a_;
   std::string str_b_;
 
-  bool IsAnagrams() const {
-    if (this->str_a_.size() != this->str_b_.size()) return false;
+  static bool IsAnagrams(std::string_view str_a,
+                         std::string_view str_b) noexcept {
+    if (str_a.size() != str_b.size()) return false;
 
-    std::vector<int> letters_a(128);
-    std::vector<int> letters_b(128);
-    for (std::size_t i = 0; i < this->str_a_.size(); i++) {
-      letters_a[this->str_a_[i]] += 1;
-      letters_b[this->str_b_[i]] += 1;
+    std::array<int, 256> letters{};
+    for (std::size_t i = 0; i < str_a.size(); i++) {
+      letters[static_cast<unsigned char>(str_a[i])] += 1;
+      letters[static_cast<unsigned char>(str_b[i])] -= 1;
     }
 
-    if (letters_a != letters_b) return false;
-
-    return true;
+    return std::all_of(letters.begin(), letters.end(),
+                       [](int count) { return count == 0; });
   }
 
-  int KSimilarity(std::string_view str_a, std::string_view str_b) const {
+  static int KSimilarity(std::string_view str_a, std::string_view str_b,
+                         [[maybe_unused]] int depth = 0) {
+    S21_METRICS_COUNT("dna_ks_nodes_total", 1);
+    S21_METRICS_OBSERVE("dna_ks_depth", depth);
     std::string str_a_copy(str_a);
     std::string str_b_copy(str_b);
     for (std::size_t i = 0; i < str_a_copy.size(); i++) {
@@ -64,7 +86,7 @@ class KString {
           if (str_a_copy[i] == str_b_copy[j]) {
             std::swap(str_a_copy[i], str_a_copy[j]);
             return 1 + KSimilarity(str_a_copy.substr(i + 1),
-                                   str_b_copy.substr(i + 1));
+                                   str_b_copy.substr(i + 1), depth + 1);
           }
         }
       }
@@ -73,7 +95,8 @@ class KString {
       for (int j : matches) {
         std::swap(str_a_copy[i], str_a_copy[j]);
         best = std::min(best, 1 + KSimilarity(str_a_copy.substr(i + 1),
-                                              str_b_copy.substr(i + 1)));
+                                              str_b_copy.substr(i + 1),
+                                              depth + 1));
         std::swap(str_a_copy[i], str_a_copy[j]);
       }
       return best;
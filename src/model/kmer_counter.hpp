@@ -0,0 +1,466 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_KMER_COUNTER_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_KMER_COUNTER_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "metrics.hpp"
+#include "thread_pool.hpp"
+
+namespace s21 {
+class KmerEncoding {
+ public:
+  static constexpr int kMaxK = 31;
+
+  static int Code(char symbol) noexcept {
+    switch (symbol) {
+      case 'A':
+      case 'a':
+        return 0;
+      case 'C':
+      case 'c':
+        return 1;
+      case 'G':
+      case 'g':
+        return 2;
+      case 'T':
+      case 't':
+        return 3;
+      default:
+        return -1;
+    }
+  }
+
+  static std::uint64_t Mask(int k) noexcept {
+    return (std::uint64_t{1} << (2 * k)) - 1;
+  }
+
+  static bool Encode(std::string_view kmer, std::uint64_t &code) noexcept {
+    code = 0;
+    for (char symbol : kmer) {
+      int value = Code(symbol);
+      if (value < 0) return false;
+      code = (code << 2) | static_cast<std::uint64_t>(value);
+    }
+    return true;
+  }
+
+  static std::string Decode(std::uint64_t code, int k) {
+    std::string kmer(k, 'A');
+    for (int i = k - 1; i >= 0; i--, code >>= 2) kmer[i] = "ACGT"[code & 3];
+    return kmer;
+  }
+
+  static std::uint64_t ReverseComplement(std::uint64_t code, int k) noexcept {
+    std::uint64_t result = 0;
+    for (int i = 0; i < k; i++, code >>= 2)
+      result = (result << 2) | (3 - (code & 3));
+    return result;
+  }
+
+  static std::uint64_t Hash(std::uint64_t key) noexcept {
+    key += 0x9e3779b97f4a7c15ULL;
+    key = (key ^ (key >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31);
+  }
+
+  template <typename OnKmer>
+  static void ForEach(std::string_view sequence, int k, bool canonical,
+                      OnKmer on_kmer) {
+    const std::uint64_t mask = Mask(k);
+    const int shift = 2 * (k - 1);
+    std::uint64_t forward = 0;
+    std::uint64_t reverse = 0;
+    int length = 0;
+    for (char symbol : sequence) {
+      int value = Code(symbol);
+      if (value < 0) {
+        length = 0;
+        continue;
+      }
+      auto code = static_cast<std::uint64_t>(value);
+      forward = ((forward << 2) | code) & mask;
+      reverse = (reverse >> 2) | ((3 - code) << shift);
+      if (++length >= k)
+        on_kmer(canonical ? std::min(forward, reverse) : forward);
+    }
+  }
+};
+
+class KmerTable {
+ public:
+  struct Entry {
+    std::uint64_t key{kEmpty};
+    std::uint64_t count{};
+  };
+
+  static constexpr std::uint64_t kEmpty = ~std::uint64_t{0};
+
+  explicit KmerTable(std::size_t capacity = 1024) {
+    std::size_t size = 16;
+    while (size < capacity) size <<= 1;
+    this->entries_.resize(size);
+  }
+
+  void Add(std::uint64_t key, std::uint64_t count = 1) {
+    if ((this->size_ + 1) * 10 > this->entries_.size() * 7) this->Grow();
+    Entry &entry = this->Find(key);
+    if (entry.key == kEmpty) {
+      entry.key = key;
+      this->size_++;
+    }
+    entry.count += count;
+  }
+
+  std::uint64_t Get(std::uint64_t key) const noexcept {
+    std::size_t mask = this->entries_.size() - 1;
+    for (std::size_t i = KmerEncoding::Hash(key) & mask;; i = (i + 1) & mask) {
+      if (this->entries_[i].key == key) return this->entries_[i].count;
+      if (this->entries_[i].key == kEmpty) return 0;
+    }
+  }
+
+  void Reserve(std::size_t size) {
+    std::size_t capacity = this->entries_.size();
+    while (size * 10 > capacity * 7) capacity <<= 1;
+    if (capacity != this->entries_.size()) this->Rehash(capacity);
+  }
+
+  std::size_t Size() const noexcept { return this->size_; }
+
+  template <typename OnEntry>
+  void ForEach(OnEntry on_entry) const {
+    for (const Entry &entry : this->entries_)
+      if (entry.key != kEmpty) on_entry(entry.key, entry.count);
+  }
+
+ private:
+  std::vector<Entry> entries_;
+  std::size_t size_{};
+
+  Entry &Find(std::uint64_t key) noexcept {
+    std::size_t mask = this->entries_.size() - 1;
+    std::size_t i = KmerEncoding::Hash(key) & mask;
+    while (this->entries_[i].key != key && this->entries_[i].key != kEmpty)
+      i = (i + 1) & mask;
+    return this->entries_[i];
+  }
+
+  void Grow() { this->Rehash(this->entries_.size() * 2); }
+
+  void Rehash(std::size_t capacity) {
+    std::vector<Entry> old(capacity);
+    old.swap(this->entries_);
+    for (const Entry &entry : old)
+      if (entry.key != kEmpty) this->Find(entry.key) = entry;
+  }
+};
+
+class CountMinSketch {
+ public:
+  CountMinSketch(std::size_t width, std::size_t depth)
+      : width_(std::max<std::size_t>(width, 1)),
+        depth_(std::max<std::size_t>(depth, 1)),
+        cells_(std::make_unique<std::atomic<std::uint32_t>[]>(this->width_ *
+                                                              this->depth_)) {
+  }
+
+  void Add(std::uint64_t key) noexcept {
+    for (std::size_t row = 0; row < this->depth_; row++)
+      this->cells_[this->Index(key, row)].fetch_add(1,
+                                                    std::memory_order_relaxed);
+  }
+
+  std::uint64_t Estimate(std::uint64_t key) const noexcept {
+    std::uint64_t estimate = ~std::uint64_t{0};
+    for (std::size_t row = 0; row < this->depth_; row++)
+      estimate = std::min<std::uint64_t>(
+          estimate, this->cells_[this->Index(key, row)].load(
+                        std::memory_order_relaxed));
+    return estimate;
+  }
+
+  std::size_t MemoryBytes() const noexcept {
+    return this->width_ * this->depth_ * sizeof(std::uint32_t);
+  }
+
+ private:
+  std::size_t width_;
+  std::size_t depth_;
+  std::unique_ptr<std::atomic<std::uint32_t>[]> cells_;
+
+  std::size_t Index(std::uint64_t key, std::size_t row) const noexcept {
+    std::uint64_t seed = row * 0x9e3779b97f4a7c15ULL;
+    std::uint64_t hash = KmerEncoding::Hash(key ^ seed);
+    return row * this->width_ + hash % this->width_;
+  }
+};
+
+class KmerCounter {
+ public:
+  enum class Mode { kExact, kSketch };
+
+  struct KmerCount {
+    std::string kmer;
+    std::uint64_t count{};
+
+    bool operator==(const KmerCount &other) const {
+      return kmer == other.kmer && count == other.count;
+    }
+  };
+
+  static constexpr std::size_t kDefaultHeavyHitters = 1024;
+
+  explicit KmerCounter(int k, bool canonical = true, Mode mode = Mode::kExact,
+                       std::size_t sketch_width = 1 << 20,
+                       std::size_t sketch_depth = 4,
+                       std::size_t heavy_hitters = kDefaultHeavyHitters)
+      : k_(k), canonical_(canonical), mode_(mode), heavy_limit_(heavy_hitters) {
+    if (k < 1 || k > KmerEncoding::kMaxK)
+      throw std::invalid_argument("k must be in [1, 31]");
+    if (mode == Mode::kSketch)
+      this->sketch_ = std::make_unique<CountMinSketch>(sketch_width,
+                                                       sketch_depth);
+  }
+
+  void Count(std::string_view sequence,
+             std::size_t threads = ThreadPool::DefaultThreads()) {
+    S21_METRICS_TIMER("dna_kmer_count_ns");
+    if (sequence.size() < static_cast<std::size_t>(this->k_)) return;
+    threads = std::clamp<std::size_t>(
+        threads, 1, std::max<std::size_t>(sequence.size() / kMinRange, 1));
+
+    const std::size_t windows = sequence.size() - this->k_ + 1;
+    S21_METRICS_COUNT("dna_kmer_windows_total", windows);
+    if (this->mode_ == Mode::kExact && threads == 1) {
+      if (this->partitions_.size() != 1) this->Repartition(1);
+      KmerTable &table = this->partitions_[0];
+      KmerEncoding::ForEach(sequence, this->k_, this->canonical_,
+                            [&](std::uint64_t key) {
+                              table.Add(key);
+                              this->total_++;
+                            });
+      return;
+    }
+
+    std::vector<std::vector<KmerTable>> local(
+        this->mode_ == Mode::kExact ? threads : 0,
+        std::vector<KmerTable>(threads, KmerTable(kLocalCapacity)));
+    std::vector<std::uint64_t> totals(threads);
+    RunInThreads(threads, [&](std::size_t t) {
+      std::size_t begin = windows * t / threads;
+      std::size_t end = windows * (t + 1) / threads;
+      std::string_view range =
+          sequence.substr(begin, end - begin + this->k_ - 1);
+      std::uint64_t total = 0;
+      if (this->mode_ == Mode::kSketch) {
+        KmerEncoding::ForEach(range, this->k_, this->canonical_,
+                              [&](std::uint64_t key) {
+                                this->sketch_->Add(key);
+                                total++;
+                              });
+      } else {
+        std::vector<KmerTable> &tables = local[t];
+        KmerEncoding::ForEach(range, this->k_, this->canonical_,
+                              [&](std::uint64_t key) {
+                                std::size_t partition =
+                                    (KmerEncoding::Hash(key) >> 32) % threads;
+                                tables[partition].Add(key);
+                                total++;
+                              });
+      }
+      totals[t] = total;
+    });
+    for (std::uint64_t total : totals) this->total_ += total;
+    if (this->mode_ == Mode::kSketch) {
+      this->TrackHeavyHitters(sequence, threads);
+      return;
+    }
+
+    if (this->partitions_.size() != threads) this->Repartition(threads);
+    RunInThreads(threads, [&](std::size_t p) {
+      KmerTable &partition = this->partitions_[p];
+      std::size_t largest = 0;
+      std::size_t size = partition.Size();
+      for (std::size_t t = 0; t < threads; t++) {
+        size += local[t][p].Size();
+        if (local[t][p].Size() > local[largest][p].Size()) largest = t;
+      }
+      if (partition.Size() == 0) std::swap(partition, local[largest][p]);
+      partition.Reserve(size);
+      for (std::size_t t = 0; t < threads; t++)
+        local[t][p].ForEach([&](std::uint64_t key, std::uint64_t count) {
+          partition.Add(key, count);
+        });
+    });
+  }
+
+  std::uint64_t GetCount(std::string_view kmer) const {
+    std::uint64_t key = 0;
+    if (kmer.size() != static_cast<std::size_t>(this->k_) ||
+        !KmerEncoding::Encode(kmer, key))
+      return 0;
+    if (this->canonical_)
+      key = std::min(key, KmerEncoding::ReverseComplement(key, this->k_));
+    if (this->mode_ == Mode::kSketch) return this->sketch_->Estimate(key);
+    return this->partitions_.empty()
+               ? 0
+               : this->partitions_[this->PartitionOf(key)].Get(key);
+  }
+
+  std::uint64_t Total() const noexcept { return this->total_; }
+
+  std::size_t Distinct() const {
+    this->RequireExact("Distinct");
+    std::size_t distinct = 0;
+    for (const auto &partition : this->partitions_)
+      distinct += partition.Size();
+    return distinct;
+  }
+
+  std::map<std::uint64_t, std::uint64_t> Histogram() const {
+    this->RequireExact("Histogram");
+    std::map<std::uint64_t, std::uint64_t> histogram;
+    for (const auto &partition : this->partitions_)
+      partition.ForEach(
+          [&](std::uint64_t, std::uint64_t count) { histogram[count]++; });
+    return histogram;
+  }
+
+  // In sketch mode the counts are count-min estimates of the tracked heavy
+  // hitters, so n may not exceed the heavy_hitters limit.
+  std::vector<KmerCount> TopN(std::size_t n) const {
+    std::vector<std::pair<std::uint64_t, std::uint64_t>> top;
+    auto greater = [](const auto &a, const auto &b) {
+      return a.first != b.first ? a.first > b.first : a.second < b.second;
+    };
+    auto offer = [&](std::uint64_t key, std::uint64_t count) {
+      if (n == 0) return;
+      top.emplace_back(count, key);
+      std::push_heap(top.begin(), top.end(), greater);
+      if (top.size() > n) {
+        std::pop_heap(top.begin(), top.end(), greater);
+        top.pop_back();
+      }
+    };
+    if (this->mode_ == Mode::kSketch) {
+      if (n > this->heavy_limit_)
+        throw std::invalid_argument("TopN exceeds tracked heavy hitters");
+      for (std::uint64_t key : this->heavy_)
+        offer(key, this->sketch_->Estimate(key));
+    } else {
+      for (const auto &partition : this->partitions_)
+        partition.ForEach(offer);
+    }
+    std::sort(top.begin(), top.end(), greater);
+
+    std::vector<KmerCount> result;
+    for (const auto &[count, key] : top)
+      result.push_back({KmerEncoding::Decode(key, this->k_), count});
+    return result;
+  }
+
+ private:
+  using Candidate = std::pair<std::uint64_t, std::uint64_t>;
+
+  static constexpr std::size_t kMinRange = 1 << 12;
+  static constexpr std::size_t kLocalCapacity = 16;
+
+  int k_;
+  bool canonical_;
+  Mode mode_;
+  std::size_t heavy_limit_;
+  std::uint64_t total_{};
+  std::vector<KmerTable> partitions_;
+  std::unique_ptr<CountMinSketch> sketch_;
+  std::vector<std::uint64_t> heavy_;
+
+  void RequireExact(const char *call) const {
+    if (this->mode_ == Mode::kSketch)
+      throw std::logic_error(std::string(call) +
+                             " is not available in sketch mode");
+  }
+
+  // Rescans the sequence against the updated sketch and keeps the keys with
+  // the largest estimates, merged with the ones tracked so far.
+  void TrackHeavyHitters(std::string_view sequence, std::size_t threads) {
+    if (this->heavy_limit_ == 0) return;
+    const std::size_t windows = sequence.size() - this->k_ + 1;
+    std::vector<std::vector<Candidate>> found(threads + 1);
+    RunInThreads(threads, [&](std::size_t t) {
+      std::size_t begin = windows * t / threads;
+      std::size_t end = windows * (t + 1) / threads;
+      std::vector<Candidate> &local = found[t];
+      std::uint64_t floor = 0;
+      KmerEncoding::ForEach(
+          sequence.substr(begin, end - begin + this->k_ - 1), this->k_,
+          this->canonical_, [&](std::uint64_t key) {
+            std::uint64_t estimate = this->sketch_->Estimate(key);
+            if (estimate < floor) return;
+            local.emplace_back(estimate, key);
+            if (local.size() >= 2 * this->heavy_limit_)
+              floor = this->KeepLargest(local);
+          });
+      this->KeepLargest(local);
+    });
+    for (std::uint64_t key : this->heavy_)
+      found[threads].emplace_back(this->sketch_->Estimate(key), key);
+
+    std::vector<Candidate> merged;
+    for (const auto &local : found)
+      merged.insert(merged.end(), local.begin(), local.end());
+    this->KeepLargest(merged);
+    this->heavy_.clear();
+    for (const Candidate &candidate : merged)
+      this->heavy_.push_back(candidate.second);
+  }
+
+  std::uint64_t KeepLargest(std::vector<Candidate> &candidates) const {
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate &a, const Candidate &b) {
+                return a.second != b.second ? a.second < b.second
+                                            : a.first > b.first;
+              });
+    candidates.erase(std::unique(candidates.begin(), candidates.end(),
+                                 [](const Candidate &a, const Candidate &b) {
+                                   return a.second == b.second;
+                                 }),
+                     candidates.end());
+    if (candidates.size() < this->heavy_limit_) return 0;
+    auto by_estimate = [](const Candidate &a, const Candidate &b) {
+      return a.first > b.first;
+    };
+    std::nth_element(candidates.begin(),
+                     candidates.begin() + (this->heavy_limit_ - 1),
+                     candidates.end(), by_estimate);
+    candidates.resize(this->heavy_limit_);
+    return candidates.back().first;
+  }
+
+  std::size_t PartitionOf(std::uint64_t key) const noexcept {
+    return (KmerEncoding::Hash(key) >> 32) % this->partitions_.size();
+  }
+
+  void Repartition(std::size_t partitions) {
+    std::vector<KmerTable> old(partitions);
+    old.swap(this->partitions_);
+    std::size_t size = 0;
+    for (const auto &partition : old) size += partition.Size();
+    for (auto &partition : this->partitions_) partition.Reserve(size);
+    for (const auto &partition : old)
+      partition.ForEach([&](std::uint64_t key, std::uint64_t count) {
+        this->partitions_[this->PartitionOf(key)].Add(key, count);
+      });
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_KMER_COUNTER_HPP_
@@ -0,0 +1,187 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_LARGE_PAGES_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_LARGE_PAGES_HPP_
+
+#include <sys/mman.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "metrics.hpp"
+
+namespace s21 {
+class LargePages {
+ public:
+  enum class Numa { kLocal, kInterleave, kBind };
+
+  struct Policy {
+    Numa numa{Numa::kLocal};
+    int node{};
+
+    bool operator==(const Policy &other) const noexcept {
+      return numa == other.numa && node == other.node;
+    }
+  };
+
+  static constexpr std::size_t kHugePageSize = 1 << 21;
+  static constexpr std::size_t kSmallAlignment = 64;
+
+  class Deleter {
+   public:
+    Deleter() = default;
+    explicit Deleter(std::size_t bytes) noexcept : bytes_(bytes) {}
+    void operator()(void *data) const noexcept {
+      LargePages::Deallocate(data, this->bytes_);
+    }
+
+   private:
+    std::size_t bytes_{};
+  };
+
+  static Policy DefaultPolicy() noexcept {
+    return {DefaultNuma().load(std::memory_order_relaxed),
+            DefaultNode().load(std::memory_order_relaxed)};
+  }
+
+  static void SetDefaultPolicy(Policy policy) noexcept {
+    DefaultNuma().store(policy.numa, std::memory_order_relaxed);
+    DefaultNode().store(policy.node, std::memory_order_relaxed);
+  }
+
+  static void *Allocate(std::size_t bytes, Policy policy = DefaultPolicy()) {
+    if (bytes < kHugePageSize)
+      return ::operator new(bytes, std::align_val_t(kSmallAlignment));
+
+    const std::size_t size = RoundUp(bytes);
+    void *data = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                  MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED) S21_METRICS_COUNT("dna_hugetlb_bytes_total", size);
+#endif
+    if (data == MAP_FAILED) {
+      data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (data == MAP_FAILED) throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+      ::madvise(data, size, MADV_HUGEPAGE);
+#endif
+      S21_METRICS_COUNT("dna_thp_bytes_total", size);
+    }
+    Bind(data, size, policy);
+    return data;
+  }
+
+  static void Deallocate(void *data, std::size_t bytes) noexcept {
+    if (data == nullptr) return;
+    if (bytes < kHugePageSize)
+      ::operator delete(data, std::align_val_t(kSmallAlignment));
+    else
+      ::munmap(data, RoundUp(bytes));
+  }
+
+  static int NodeCount() {
+    static const int count = []() {
+      int nodes = 0;
+      std::error_code error;
+      while (std::filesystem::exists(
+          "/sys/devices/system/node/node" + std::to_string(nodes), error))
+        nodes++;
+      return nodes == 0 ? 1 : nodes;
+    }();
+    return count;
+  }
+
+ private:
+  static std::atomic<Numa> &DefaultNuma() noexcept {
+    static std::atomic<Numa> numa{Numa::kLocal};
+    return numa;
+  }
+
+  static std::atomic<int> &DefaultNode() noexcept {
+    static std::atomic<int> node{0};
+    return node;
+  }
+
+  static std::size_t RoundUp(std::size_t bytes) noexcept {
+    return (bytes + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+  }
+
+  static void Bind(void *data, std::size_t size, Policy policy) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+    if (policy.numa == Numa::kLocal || NodeCount() < 2) return;
+    const int nodes = NodeCount();
+    std::vector<unsigned long> mask(nodes / (8 * sizeof(unsigned long)) + 1);
+    auto set = [&mask](int node) {
+      mask[node / (8 * sizeof(unsigned long))] |=
+          1UL << (node % (8 * sizeof(unsigned long)));
+    };
+    if (policy.numa == Numa::kInterleave) {
+      for (int node = 0; node < nodes; node++) set(node);
+    } else if (policy.node >= 0 && policy.node < nodes) {
+      set(policy.node);
+    } else {
+      return;
+    }
+    int mode = policy.numa == Numa::kInterleave ? MPOL_INTERLEAVE : MPOL_BIND;
+    if (::syscall(SYS_mbind, data, size, mode, mask.data(),
+                  mask.size() * 8 * sizeof(unsigned long), 0) != 0)
+      S21_METRICS_COUNT("dna_mbind_failures_total", 1);
+#else
+    static_cast<void>(data);
+    static_cast<void>(size);
+    static_cast<void>(policy);
+#endif
+  }
+};
+
+template <typename T>
+class LargePageAllocator {
+ public:
+  using value_type = T;
+
+  LargePageAllocator() noexcept : policy_(LargePages::DefaultPolicy()) {}
+  explicit LargePageAllocator(LargePages::Policy policy) noexcept
+      : policy_(policy) {}
+  template <typename U>
+  LargePageAllocator(const LargePageAllocator<U> &other) noexcept
+      : policy_(other.Policy()) {}
+
+  T *allocate(std::size_t count) {
+    return static_cast<T *>(
+        LargePages::Allocate(count * sizeof(T), this->policy_));
+  }
+
+  void deallocate(T *data, std::size_t count) noexcept {
+    LargePages::Deallocate(data, count * sizeof(T));
+  }
+
+  LargePages::Policy Policy() const noexcept { return this->policy_; }
+
+  template <typename U>
+  bool operator==(const LargePageAllocator<U> &other) const noexcept {
+    return this->policy_ == other.Policy();
+  }
+  template <typename U>
+  bool operator!=(const LargePageAllocator<U> &other) const noexcept {
+    return !(*this == other);
+  }
+
+ private:
+  LargePages::Policy policy_;
+};
+
+using LargeString =
+    std::basic_string<char, std::char_traits<char>, LargePageAllocator<char>>;
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_LARGE_PAGES_HPP_
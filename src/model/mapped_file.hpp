@@ -0,0 +1,88 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_MAPPED_FILE_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_MAPPED_FILE_HPP_
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace s21 {
+class MappedFile {
+ public:
+  MappedFile() = default;
+
+  MappedFile(std::string_view path, std::size_t offset, std::size_t length) {
+    int fd = ::open(std::string(path).c_str(), O_RDONLY);
+    if (fd < 0) return;
+    std::size_t file_size = FileSize(fd);
+    offset = std::min(offset, file_size);
+    length = std::min(length, file_size - offset);
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t start = offset - offset % page;
+    this->skip_ = offset - start;
+    this->mapped_ = length + this->skip_;
+    if (length > 0) {
+      void *data = ::mmap(nullptr, this->mapped_, PROT_READ, MAP_PRIVATE, fd,
+                          static_cast<off_t>(start));
+      if (data != MAP_FAILED) {
+        this->data_ = static_cast<char *>(data);
+        this->length_ = length;
+        ::madvise(data, this->mapped_, MADV_SEQUENTIAL);
+      }
+    }
+    ::close(fd);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  MappedFile(MappedFile &&other) noexcept { this->Swap(other); }
+  MappedFile &operator=(MappedFile &&other) noexcept {
+    this->Swap(other);
+    return *this;
+  }
+
+  ~MappedFile() {
+    if (this->data_ != nullptr) ::munmap(this->data_, this->mapped_);
+  }
+
+  static std::size_t FileSize(std::string_view path) {
+    struct stat info {};
+    if (::stat(std::string(path).c_str(), &info) != 0) return 0;
+    return static_cast<std::size_t>(info.st_size);
+  }
+
+  bool IsOpen() const noexcept { return this->data_ != nullptr; }
+
+  std::string_view View() const noexcept {
+    if (this->data_ == nullptr) return {};
+    return {this->data_ + this->skip_, this->length_};
+  }
+
+ private:
+  char *data_{};
+  std::size_t mapped_{};
+  std::size_t skip_{};
+  std::size_t length_{};
+
+  static std::size_t FileSize(int fd) {
+    struct stat info {};
+    if (::fstat(fd, &info) != 0) return 0;
+    return static_cast<std::size_t>(info.st_size);
+  }
+
+  void Swap(MappedFile &other) noexcept {
+    std::swap(this->data_, other.data_);
+    std::swap(this->mapped_, other.mapped_);
+    std::swap(this->skip_, other.skip_);
+    std::swap(this->length_, other.length_);
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_MAPPED_FILE_HPP_
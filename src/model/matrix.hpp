@@ -0,0 +1,126 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_MATRIX_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_MATRIX_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "arena.hpp"
+#include "large_pages.hpp"
+
+namespace s21 {
+inline constexpr std::size_t kRowAlignment = 64;
+
+template <typename T>
+class Matrix2D {
+ public:
+  static_assert(std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>,
+                "Use BitMatrix for boolean cells");
+
+  Matrix2D() = default;
+
+  Matrix2D(std::size_t rows, std::size_t cols)
+      : rows_(rows), cols_(cols), stride_(AlignedStride(cols)) {
+    this->storage_.resize(rows * this->stride_ + kPadding);
+    this->data_ = Align(this->storage_.data());
+  }
+
+  Matrix2D(std::size_t rows, std::size_t cols, Arena &arena)
+      : rows_(rows), cols_(cols), stride_(AlignedStride(cols)) {
+    this->data_ = arena.Allocate<T>(rows * this->stride_, kRowAlignment);
+  }
+
+  Matrix2D(const Matrix2D &) = delete;
+  Matrix2D &operator=(const Matrix2D &) = delete;
+  Matrix2D(Matrix2D &&) noexcept = default;
+  Matrix2D &operator=(Matrix2D &&) noexcept = default;
+  ~Matrix2D() = default;
+
+  std::size_t Rows() const noexcept { return this->rows_; }
+  std::size_t Cols() const noexcept { return this->cols_; }
+  std::size_t Stride() const noexcept { return this->stride_; }
+
+  T *operator[](std::size_t row) noexcept {
+    return this->data_ + row * this->stride_;
+  }
+  const T *operator[](std::size_t row) const noexcept {
+    return this->data_ + row * this->stride_;
+  }
+
+  T &operator()(std::size_t row, std::size_t col) noexcept {
+    return this->data_[row * this->stride_ + col];
+  }
+  T operator()(std::size_t row, std::size_t col) const noexcept {
+    return this->data_[row * this->stride_ + col];
+  }
+
+ private:
+  static constexpr std::size_t kPadding = kRowAlignment / sizeof(T);
+
+  std::size_t rows_{};
+  std::size_t cols_{};
+  std::size_t stride_{};
+  T *data_{};
+  std::vector<T, LargePageAllocator<T>> storage_;
+
+  static std::size_t AlignedStride(std::size_t cols) noexcept {
+    std::size_t cells = kRowAlignment / sizeof(T);
+    if (cells == 0) return cols;
+    return (cols + cells - 1) / cells * cells;
+  }
+
+  static T *Align(T *data) noexcept {
+    auto address = reinterpret_cast<std::uintptr_t>(data);
+    address = (address + kRowAlignment - 1) / kRowAlignment * kRowAlignment;
+    return reinterpret_cast<T *>(address);
+  }
+};
+
+// Boolean cells packed 64 per word on top of Matrix2D, so every row starts
+// on its own cache line. Cells start cleared, also when taken from an arena.
+class BitMatrix {
+ public:
+  using Word = std::uint64_t;
+  static constexpr std::size_t kWordBits = 64;
+
+  BitMatrix() = default;
+
+  BitMatrix(std::size_t rows, std::size_t cols)
+      : words_(rows, WordsPerRow(cols)), cols_(cols) {}
+
+  BitMatrix(std::size_t rows, std::size_t cols, Arena &arena)
+      : words_(rows, WordsPerRow(cols), arena), cols_(cols) {
+    for (std::size_t row = 0; row < rows; row++)
+      std::fill_n(this->words_[row], this->Words(), Word{});
+  }
+
+  std::size_t Rows() const noexcept { return this->words_.Rows(); }
+  std::size_t Cols() const noexcept { return this->cols_; }
+  std::size_t Words() const noexcept { return this->words_.Cols(); }
+
+  bool Get(std::size_t row, std::size_t col) const noexcept {
+    return (this->words_(row, col / kWordBits) >> (col % kWordBits)) & 1U;
+  }
+
+  void Set(std::size_t row, std::size_t col, bool value) noexcept {
+    Word &word = this->words_(row, col / kWordBits);
+    Word mask = Word{1} << (col % kWordBits);
+    word = value ? (word | mask) : (word & ~mask);
+  }
+
+  Word *Row(std::size_t row) noexcept { return this->words_[row]; }
+  const Word *Row(std::size_t row) const noexcept { return this->words_[row]; }
+
+ private:
+  Matrix2D<Word> words_;
+  std::size_t cols_{};
+
+  static std::size_t WordsPerRow(std::size_t cols) noexcept {
+    return (cols + kWordBits - 1) / kWordBits;
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_MATRIX_HPP_
@@ -0,0 +1,194 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_METRICS_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_METRICS_HPP_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+namespace s21 {
+class Metrics {
+ public:
+  class Counter {
+   public:
+    void Add(std::uint64_t value) noexcept {
+      this->value_.fetch_add(value, std::memory_order_relaxed);
+    }
+    std::uint64_t Value() const noexcept {
+      return this->value_.load(std::memory_order_relaxed);
+    }
+    void Reset() noexcept { this->value_.store(0, std::memory_order_relaxed); }
+
+   private:
+    std::atomic<std::uint64_t> value_{};
+  };
+
+  class Histogram {
+   public:
+    static constexpr std::size_t kBuckets = 40;
+
+    void Observe(std::uint64_t value) noexcept {
+      std::size_t bucket = 0;
+      while (bucket + 1 < kBuckets && (std::uint64_t{1} << bucket) < value)
+        bucket++;
+      this->buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+      this->sum_.fetch_add(value, std::memory_order_relaxed);
+      this->count_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static std::uint64_t UpperBound(std::size_t bucket) noexcept {
+      return std::uint64_t{1} << bucket;
+    }
+    std::uint64_t Bucket(std::size_t bucket) const noexcept {
+      return this->buckets_[bucket].load(std::memory_order_relaxed);
+    }
+    std::uint64_t Sum() const noexcept {
+      return this->sum_.load(std::memory_order_relaxed);
+    }
+    std::uint64_t Count() const noexcept {
+      return this->count_.load(std::memory_order_relaxed);
+    }
+
+    void Reset() noexcept {
+      for (auto &bucket : this->buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+      this->sum_.store(0, std::memory_order_relaxed);
+      this->count_.store(0, std::memory_order_relaxed);
+    }
+
+   private:
+    std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+    std::atomic<std::uint64_t> sum_{};
+    std::atomic<std::uint64_t> count_{};
+  };
+
+  class ScopedTimer {
+   public:
+    explicit ScopedTimer(Histogram &histogram) noexcept
+        : histogram_(histogram), start_(std::chrono::steady_clock::now()) {}
+    ScopedTimer(const ScopedTimer &) = delete;
+    ScopedTimer &operator=(const ScopedTimer &) = delete;
+    ~ScopedTimer() {
+      auto elapsed = std::chrono::steady_clock::now() - this->start_;
+      this->histogram_.Observe(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count());
+    }
+
+   private:
+    Histogram &histogram_;
+    std::chrono::steady_clock::time_point start_;
+  };
+
+  static Metrics &Instance() {
+    static Metrics metrics;
+    return metrics;
+  }
+
+  Counter &GetCounter(std::string_view name) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    auto &counter = this->counters_[std::string(name)];
+    if (!counter) counter = std::make_unique<Counter>();
+    return *counter;
+  }
+
+  Histogram &GetHistogram(std::string_view name) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    auto &histogram = this->histograms_[std::string(name)];
+    if (!histogram) histogram = std::make_unique<Histogram>();
+    return *histogram;
+  }
+
+  void Reset() {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    for (auto &[name, counter] : this->counters_) counter->Reset();
+    for (auto &[name, histogram] : this->histograms_) histogram->Reset();
+  }
+
+  std::string ToPrometheus() const {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    std::ostringstream out;
+    for (const auto &[name, counter] : this->counters_) {
+      out << "# TYPE " << name << " counter\n";
+      out << name << ' ' << counter->Value() << '\n';
+    }
+    for (const auto &[name, histogram] : this->histograms_) {
+      out << "# TYPE " << name << " histogram\n";
+      std::uint64_t cumulative = 0;
+      for (std::size_t i = 0; i < Histogram::kBuckets; i++) {
+        cumulative += histogram->Bucket(i);
+        out << name << "_bucket{le=\"" << Histogram::UpperBound(i) << "\"} "
+            << cumulative << '\n';
+      }
+      out << name << "_bucket{le=\"+Inf\"} " << histogram->Count() << '\n';
+      out << name << "_sum " << histogram->Sum() << '\n';
+      out << name << "_count " << histogram->Count() << '\n';
+    }
+    return out.str();
+  }
+
+  std::string ToJson() const {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    std::ostringstream out;
+    out << "{\"counters\":{";
+    const char *separator = "";
+    for (const auto &[name, counter] : this->counters_) {
+      out << separator << '"' << name << "\":" << counter->Value();
+      separator = ",";
+    }
+    out << "},\"histograms\":{";
+    separator = "";
+    for (const auto &[name, histogram] : this->histograms_) {
+      out << separator << '"' << name << "\":{\"count\":" << histogram->Count()
+          << ",\"sum\":" << histogram->Sum() << ",\"buckets\":[";
+      for (std::size_t i = 0; i < Histogram::kBuckets; i++)
+        out << (i == 0 ? "" : ",") << histogram->Bucket(i);
+      out << "]}";
+      separator = ",";
+    }
+    out << "}}";
+    return out.str();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::unique_ptr<Counter>> counters_;
+  std::map<std::string, std::unique_ptr<Histogram>> histograms_;
+
+  Metrics() = default;
+};
+}  // namespace s21
+
+#define S21_METRICS_CONCAT_IMPL(a, b) a##b
+#define S21_METRICS_CONCAT(a, b) S21_METRICS_CONCAT_IMPL(a, b)
+
+#ifdef S21_DNA_METRICS
+#define S21_METRICS_COUNT(name, value)                                        \
+  do {                                                                        \
+    static auto &s21_counter = ::s21::Metrics::Instance().GetCounter(name);   \
+    s21_counter.Add(value);                                                   \
+  } while (0)
+#define S21_METRICS_OBSERVE(name, value)                                      \
+  do {                                                                        \
+    static auto &s21_histogram =                                              \
+        ::s21::Metrics::Instance().GetHistogram(name);                        \
+    s21_histogram.Observe(value);                                             \
+  } while (0)
+#define S21_METRICS_TIMER(name)                                               \
+  static auto &S21_METRICS_CONCAT(s21_timer_histogram_, __LINE__) =           \
+      ::s21::Metrics::Instance().GetHistogram(name);                          \
+  ::s21::Metrics::ScopedTimer S21_METRICS_CONCAT(s21_timer_, __LINE__)(       \
+      S21_METRICS_CONCAT(s21_timer_histogram_, __LINE__))
+#else
+#define S21_METRICS_COUNT(name, value) static_cast<void>(0)
+#define S21_METRICS_OBSERVE(name, value) static_cast<void>(0)
+#define S21_METRICS_TIMER(name) static_cast<void>(0)
+#endif
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_METRICS_HPP_
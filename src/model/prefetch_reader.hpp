@@ -0,0 +1,161 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_PREFETCH_READER_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_PREFETCH_READER_HPP_
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "bounded_queue.hpp"
+#include "metrics.hpp"
+
+namespace s21 {
+class PrefetchReader {
+ public:
+  struct Chunk {
+    std::size_t offset{};
+    std::size_t owned{};
+    std::string data;
+  };
+
+  static constexpr std::size_t kDefaultChunkSize = 1 << 22;
+  static constexpr std::size_t kDefaultBuffers = 8;
+
+  PrefetchReader(std::string_view path, std::size_t overlap,
+                 std::size_t chunk_size = kDefaultChunkSize,
+                 std::size_t buffers = kDefaultBuffers)
+      : overlap_(overlap),
+        chunk_size_(chunk_size == 0 ? kDefaultChunkSize : chunk_size),
+        free_(buffers),
+        full_(buffers) {
+    this->fd_ = ::open(std::string(path).c_str(), O_RDONLY);
+    if (this->fd_ < 0) {
+      this->done_.store(true, std::memory_order_release);
+      return;
+    }
+    struct stat info {};
+    if (::fstat(this->fd_, &info) == 0)
+      this->file_size_ = static_cast<std::size_t>(info.st_size);
+#ifdef POSIX_FADV_SEQUENTIAL
+    ::posix_fadvise(this->fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+    for (std::size_t i = 0; i < buffers; i++) this->free_.TryPush(Chunk{});
+    this->reader_ = std::thread([this]() { this->Produce(); });
+  }
+
+  PrefetchReader(const PrefetchReader &) = delete;
+  PrefetchReader &operator=(const PrefetchReader &) = delete;
+
+  ~PrefetchReader() {
+    this->stop_.store(true, std::memory_order_release);
+    this->Notify(this->space_);
+    if (this->reader_.joinable()) this->reader_.join();
+    if (this->fd_ >= 0) ::close(this->fd_);
+  }
+
+  bool IsOpen() const noexcept { return this->fd_ >= 0; }
+  bool HasError() const noexcept {
+    return this->error_.load(std::memory_order_acquire);
+  }
+  std::size_t FileSize() const noexcept { return this->file_size_; }
+
+  bool Next(Chunk &chunk) {
+    bool popped = false;
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->ready_.wait(lock, [&]() {
+      const bool done = this->done_.load(std::memory_order_acquire);
+      popped = this->full_.TryPop(chunk);
+      return popped || done;
+    });
+    return popped;
+  }
+
+  void Release(Chunk &&chunk) {
+    this->free_.TryPush(std::move(chunk));
+    this->Notify(this->space_);
+  }
+
+ private:
+  int fd_{-1};
+  std::size_t file_size_{};
+  std::size_t overlap_;
+  std::size_t chunk_size_;
+  BoundedQueue<Chunk> free_;
+  BoundedQueue<Chunk> full_;
+  std::atomic<bool> done_{};
+  std::atomic<bool> stop_{};
+  std::atomic<bool> error_{};
+  std::mutex mutex_;
+  std::condition_variable ready_;
+  std::condition_variable space_;
+  std::thread reader_;
+
+  void Produce() {
+    for (std::size_t offset = 0; offset < this->file_size_;
+         offset += this->chunk_size_) {
+      Chunk chunk;
+      if (!this->WaitFor([&]() { return this->free_.TryPop(chunk); }))
+        return this->Finish();
+
+      std::size_t owned =
+          std::min(this->chunk_size_, this->file_size_ - offset);
+      std::size_t size =
+          std::min(owned + this->overlap_, this->file_size_ - offset);
+      chunk.offset = offset;
+      chunk.owned = owned;
+      chunk.data.resize(size);
+      if (!this->ReadAt(chunk.data.data(), size, offset)) {
+        this->error_.store(true, std::memory_order_release);
+        return this->Finish();
+      }
+
+      if (!this->WaitFor([&]() {
+            return this->full_.TryPush(std::move(chunk));
+          }))
+        return this->Finish();
+      this->Notify(this->ready_);
+    }
+    this->Finish();
+  }
+
+  template <typename Ready>
+  bool WaitFor(Ready ready) {
+    std::unique_lock<std::mutex> lock(this->mutex_);
+    this->space_.wait(lock, [&]() {
+      return this->stop_.load(std::memory_order_acquire) || ready();
+    });
+    return !this->stop_.load(std::memory_order_acquire);
+  }
+
+  void Notify(std::condition_variable &condition) {
+    { std::lock_guard<std::mutex> lock(this->mutex_); }
+    condition.notify_all();
+  }
+
+  bool ReadAt(char *buffer, std::size_t size, std::size_t offset) const {
+    S21_METRICS_TIMER("dna_prefetch_read_ns");
+    std::size_t done = 0;
+    while (done < size) {
+      ssize_t bytes = ::pread(this->fd_, buffer + done, size - done,
+                              static_cast<off_t>(offset + done));
+      if (bytes <= 0) return false;
+      done += static_cast<std::size_t>(bytes);
+    }
+    return true;
+  }
+
+  void Finish() {
+    this->done_.store(true, std::memory_order_release);
+    this->Notify(this->ready_);
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_PREFETCH_READER_HPP_
@@ -1,12 +1,20 @@
 #ifndef A7_DNA_ANALYZER_1_1_MODEL_REGEX_HPP_
 #define A7_DNA_ANALYZER_1_1_MODEL_REGEX_HPP_
 
+#include <array>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
+#include "arena.hpp"
+#include "matrix.hpp"
+#include "metrics.hpp"
+#include "regex_program.hpp"
+
 namespace fs = std::filesystem;
 
 namespace s21 {
@@ -25,39 +33,90 @@ class Regex {
     file.close();
   }
 
-  bool IsMatch() const {
-    if (this->expr_.empty()) return this->str_.empty();
-
-    int s_size = static_cast<int>(this->str_.size());
-    int e_size = static_cast<int>(this->expr_.size());
-    std::vector<std::vector<bool>> dp(s_size + 1,
-                                      std::vector<bool>(e_size + 1));
-
-    dp[s_size][e_size] = true;
-    for (int i = s_size; i >= 0; i--) {
-      for (int j = e_size - 1; j >= 0; j--) {
-        bool first_match = (i < s_size && (this->expr_[j] == this->str_[i] ||
-                                           this->expr_[j] == '.'));
-
-        if (this->expr_[j] == '*') {
-          dp[i][j] = dp[i][j + 1] || (i < s_size && dp[i + 1][j]);
-        } else if (j + 1 < e_size && this->expr_[j + 1] == '+') {
-          dp[i][j] = dp[i][j + 2] || (first_match && dp[i + 1][j]);
-        } else if (this->expr_[j] == '?') {
-          dp[i][j] = dp[i][j + 1] || (first_match && dp[i + 1][j + 1]);
-        } else if (this->expr_[j] == '+') {
-          dp[i][j] = false;
-        } else {
-          dp[i][j] = first_match && dp[i + 1][j + 1];
-        }
+  bool IsMatch() const { return IsMatch(this->str_, this->expr_); }
+
+  static bool IsMatch(std::string_view str, std::string_view expr,
+                      Arena *arena = nullptr) {
+    if (expr.empty()) return str.empty();
+    S21_METRICS_TIMER("dna_regex_match_ns");
+    std::vector<RegexToken> tokens;
+    if (!RegexToken::Tokenize(expr, tokens)) return false;
+    if (arena == nullptr) arena = &Arena::ThreadLocal();
+    Arena::Scope scope(*arena);
+
+    const std::size_t top = tokens.size();
+    const std::size_t words = top / 64 + 1;
+    std::array<std::uint16_t, 256> classes{};
+    std::size_t class_count = 1;
+    for (const RegexToken &token : tokens)
+      if (token.symbol != '.' && classes[Byte(token.symbol)] == 0)
+        classes[Byte(token.symbol)] = class_count++;
+
+    // Bit top - j of row c is set when token j accepts symbols of class c.
+    BitMatrix step(class_count, top + 1, *arena);
+    BitMatrix loop(class_count, top + 1, *arena);
+    std::uint64_t *skip = arena->AllocateZeroed<std::uint64_t>(words);
+    std::uint64_t *starts = arena->Allocate<std::uint64_t>(words);
+    std::uint64_t *prev = arena->AllocateZeroed<std::uint64_t>(words);
+    std::uint64_t *row = arena->Allocate<std::uint64_t>(words);
+    for (std::size_t j = 0; j < top; j++) {
+      const std::size_t bit = top - j;
+      const std::uint64_t flag = std::uint64_t{1} << (bit % 64);
+      BitMatrix &masks =
+          tokens[j].kind == RegexToken::Kind::kStar ? loop : step;
+      if (tokens[j].kind != RegexToken::Kind::kOne) skip[bit / 64] |= flag;
+      for (std::size_t c = 0; c < class_count; c++)
+        if (tokens[j].symbol == '.' || classes[Byte(tokens[j].symbol)] == c)
+          masks.Set(c, bit, true);
+    }
+    std::uint64_t carry = 0;
+    for (std::size_t w = 0; w < words; w++) {
+      starts[w] = skip[w] & ~((skip[w] << 1) | carry);
+      carry = skip[w] >> 63;
+    }
+    S21_METRICS_COUNT("dna_regex_cells_total", (str.size() + 1) * top);
+
+    prev[0] = 1;
+    Flood(prev, skip, starts, words);
+    for (std::size_t i = str.size(); i-- > 0;) {
+      const std::uint64_t *step_row = step.Row(classes[Byte(str[i])]);
+      const std::uint64_t *loop_row = loop.Row(classes[Byte(str[i])]);
+      std::uint64_t alive = 0;
+      carry = 0;
+      for (std::size_t w = 0; w < words; w++) {
+        row[w] = (step_row[w] & ((prev[w] << 1) | carry)) |
+                 (loop_row[w] & prev[w]);
+        carry = prev[w] >> 63;
+        alive |= row[w];
       }
+      if (alive == 0) return false;
+      Flood(row, skip, starts, words);
+      std::swap(prev, row);
     }
-    return dp[0][0];
+    return (prev[top / 64] >> (top % 64)) & 1;
   }
 
  private:
   std::string str_;
   std::string expr_;
+
+  static unsigned char Byte(char symbol) noexcept {
+    return static_cast<unsigned char>(symbol);
+  }
+
+  static void Flood(std::uint64_t *row, const std::uint64_t *skip,
+                    const std::uint64_t *starts, std::size_t words) noexcept {
+    std::uint64_t shift_carry = 0, add_carry = 0;
+    for (std::size_t w = 0; w < words; w++) {
+      std::uint64_t seeds = ((row[w] << 1) | shift_carry) & skip[w];
+      shift_carry = row[w] >> 63;
+      std::uint64_t rest = skip[w] & ~seeds;
+      std::uint64_t partial = rest + (starts[w] & rest);
+      std::uint64_t sum = partial + add_carry;
+      add_carry = (partial < rest) | (sum < partial);
+      row[w] |= skip[w] & ~(rest & (sum ^ rest));
+    }
+  }
 };
 }  // namespace s21
 
@@ -0,0 +1,230 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_REGEX_PROGRAM_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_REGEX_PROGRAM_HPP_
+
+#include <array>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "metrics.hpp"
+
+namespace s21 {
+struct RegexToken {
+  enum class Kind { kOne, kStar, kOptional };
+
+  Kind kind{};
+  char symbol{};
+
+  static bool Tokenize(std::string_view expr, std::vector<RegexToken> &tokens) {
+    tokens.clear();
+    for (std::size_t j = 0; j < expr.size(); j++) {
+      if (expr[j] == '*') {
+        tokens.push_back({Kind::kStar, '.'});
+      } else if (j + 1 < expr.size() && expr[j + 1] == '+') {
+        tokens.push_back({Kind::kStar, expr[j++]});
+      } else if (expr[j] == '?') {
+        tokens.push_back({Kind::kOptional, '?'});
+      } else if (expr[j] == '+') {
+        return false;
+      } else {
+        tokens.push_back({Kind::kOne, expr[j]});
+      }
+    }
+    return true;
+  }
+};
+
+class RegexProgram {
+ public:
+  RegexProgram() = default;
+  explicit RegexProgram(std::string_view expr)
+      : RegexProgram(std::vector<std::string_view>{expr}) {}
+
+  explicit RegexProgram(const std::vector<std::string_view> &exprs) {
+    S21_METRICS_TIMER("dna_regex_compile_ns");
+    std::vector<std::vector<RegexToken>> programs(exprs.size());
+    std::vector<bool> valid(exprs.size());
+    std::size_t bits = 0;
+    for (std::size_t k = 0; k < exprs.size(); k++) {
+      valid[k] = RegexToken::Tokenize(exprs[k], programs[k]);
+      bits += programs[k].size() + 1;
+      for (const RegexToken &token : programs[k])
+        if (token.symbol != '.' && this->classes_[Byte(token.symbol)] == 0)
+          this->classes_[Byte(token.symbol)] = ++this->class_count_;
+    }
+    this->class_count_++;
+    this->words_ = (bits + 63) / 64;
+    this->consume_.assign(this->class_count_ * this->words_, 0);
+    this->loop_.assign(this->class_count_ * this->words_, 0);
+    this->skip_.assign(this->words_, 0);
+    this->start_.assign(this->words_, 0);
+
+    std::size_t offset = 0;
+    for (std::size_t k = 0; k < exprs.size(); k++) {
+      const std::vector<RegexToken> &tokens = programs[k];
+      for (std::size_t j = 0; j < tokens.size(); j++) {
+        const std::size_t bit = offset + j;
+        if (tokens[j].kind != RegexToken::Kind::kOne) SetBit(this->skip_, bit);
+        auto &masks = tokens[j].kind == RegexToken::Kind::kStar
+                          ? this->loop_
+                          : this->consume_;
+        for (std::size_t c = 0; c < this->class_count_; c++)
+          if (tokens[j].symbol == '.' ||
+              this->classes_[Byte(tokens[j].symbol)] == c)
+            masks[c * this->words_ + bit / 64] |= std::uint64_t{1}
+                                                  << (bit % 64);
+      }
+      if (valid[k]) SetBit(this->start_, offset);
+      offset += tokens.size();
+      this->accepts_.push_back(offset++);
+    }
+    this->Closure(this->start_);
+  }
+
+  ~RegexProgram() = default;
+
+  std::size_t Size() const noexcept { return this->accepts_.size(); }
+
+  bool IsMatch(std::string_view str) const {
+    return this->Size() > 0 && this->Run(str, false)[0];
+  }
+
+  std::vector<bool> Match(std::string_view str) const {
+    return this->Run(str, false);
+  }
+
+  std::vector<bool> Search(std::string_view str) const {
+    return this->Run(str, true);
+  }
+
+ private:
+  std::array<std::uint16_t, 256> classes_{};
+  std::size_t class_count_{};
+  std::size_t words_{};
+  std::vector<std::uint64_t> consume_;
+  std::vector<std::uint64_t> loop_;
+  std::vector<std::uint64_t> skip_;
+  std::vector<std::uint64_t> start_;
+  std::vector<std::size_t> accepts_;
+
+  static unsigned char Byte(char symbol) noexcept {
+    return static_cast<unsigned char>(symbol);
+  }
+
+  static void SetBit(std::vector<std::uint64_t> &mask, std::size_t bit) {
+    mask[bit / 64] |= std::uint64_t{1} << (bit % 64);
+  }
+
+  static bool GetBit(const std::vector<std::uint64_t> &mask,
+                     std::size_t bit) noexcept {
+    return (mask[bit / 64] >> (bit % 64)) & 1;
+  }
+
+  void Closure(std::vector<std::uint64_t> &state) const noexcept {
+    bool changed = true;
+    while (changed) {
+      changed = false;
+      std::uint64_t carry = 0;
+      for (std::size_t w = 0; w < this->words_; w++) {
+        std::uint64_t skip = state[w] & this->skip_[w];
+        std::uint64_t add = ((skip << 1) | carry) & ~state[w];
+        carry = skip >> 63;
+        if (add != 0) {
+          state[w] |= add;
+          changed = true;
+        }
+      }
+    }
+  }
+
+  void Collect(const std::vector<std::uint64_t> &state,
+               std::vector<bool> &found) const {
+    for (std::size_t k = 0; k < this->accepts_.size(); k++)
+      if (GetBit(state, this->accepts_[k])) found[k] = true;
+  }
+
+  std::vector<bool> Run(std::string_view str, bool search) const {
+    S21_METRICS_TIMER("dna_regex_match_ns");
+    std::vector<bool> found(this->Size());
+    std::vector<std::uint64_t> state(this->start_);
+    std::vector<std::uint64_t> next(this->words_);
+    if (search) this->Collect(state, found);
+
+    for (char ch : str) {
+      const std::size_t row = this->classes_[Byte(ch)] * this->words_;
+      std::uint64_t carry = 0, alive = 0;
+      for (std::size_t w = 0; w < this->words_; w++) {
+        std::uint64_t moved = state[w] & this->consume_[row + w];
+        next[w] = (moved << 1) | carry | (state[w] & this->loop_[row + w]);
+        if (search) next[w] |= this->start_[w];
+        carry = moved >> 63;
+        alive |= next[w];
+      }
+      if (alive == 0) return found;
+      this->Closure(next);
+      state.swap(next);
+      if (search) this->Collect(state, found);
+    }
+    if (!search) this->Collect(state, found);
+    return found;
+  }
+};
+
+class RegexCache {
+ public:
+  static constexpr std::size_t kDefaultCapacity = 256;
+
+  explicit RegexCache(std::size_t capacity = kDefaultCapacity)
+      : capacity_(capacity == 0 ? 1 : capacity) {}
+  ~RegexCache() = default;
+
+  RegexCache(const RegexCache &) = delete;
+  RegexCache &operator=(const RegexCache &) = delete;
+
+  static RegexCache &Shared() {
+    static RegexCache cache;
+    return cache;
+  }
+
+  std::shared_ptr<const RegexProgram> Get(std::string_view expr) {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    auto found = this->index_.find(expr);
+    if (found != this->index_.end()) {
+      S21_METRICS_COUNT("dna_regex_cache_hits_total", 1);
+      this->entries_.splice(this->entries_.begin(), this->entries_,
+                            found->second);
+      return found->second->second;
+    }
+    S21_METRICS_COUNT("dna_regex_cache_misses_total", 1);
+    this->entries_.emplace_front(std::string(expr),
+                                 std::make_shared<const RegexProgram>(expr));
+    this->index_.emplace(this->entries_.front().first, this->entries_.begin());
+    if (this->entries_.size() > this->capacity_) {
+      this->index_.erase(this->entries_.back().first);
+      this->entries_.pop_back();
+    }
+    return this->entries_.front().second;
+  }
+
+  std::size_t Size() const {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    return this->entries_.size();
+  }
+
+ private:
+  using Entry = std::pair<std::string, std::shared_ptr<const RegexProgram>>;
+
+  std::size_t capacity_;
+  mutable std::mutex mutex_;
+  std::list<Entry> entries_;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_REGEX_PROGRAM_HPP_
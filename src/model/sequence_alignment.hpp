@@ -2,31 +2,111 @@
 #define A7_DNA_ANALYZER_1_1_MODEL_NW_ALGORITHM_HPP_
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <utility>
 #include <vector>
+#include "arena.hpp"
+#include "matrix.hpp"
+#include "metrics.hpp"
 
 namespace fs = std::filesystem;
 
 namespace s21 {
 class NeedlemanWunsch {
  public:
-  using Matrix = std::vector<std::vector<int>>;
-
   struct Sequences {
     int optimal_score{};
     std::string alignment_a;
     std::string alignment_b;
   };
 
+  struct Scoring {
+    int match{};
+    int mismatch{};
+    int gap{};
+  };
+
+  struct CigarOp {
+    char op{};
+    int length{};
+
+    bool operator==(const CigarOp &other) const noexcept {
+      return op == other.op && length == other.length;
+    }
+  };
+
+  struct Alignment {
+    int optimal_score{};
+    std::vector<CigarOp> cigar;
+    std::string seq_a;
+    std::string seq_b;
+
+    std::string Cigar() const {
+      std::string result;
+      for (const CigarOp &run : this->cigar)
+        result += std::to_string(run.length) + run.op;
+      return result.empty() ? "*" : result;
+    }
+
+    std::string GappedA() const { return this->Gapped(this->seq_a, 'I'); }
+    std::string GappedB() const { return this->Gapped(this->seq_b, 'D'); }
+
+    std::string ToSam(std::string_view qname = "seq_b",
+                      std::string_view rname = "seq_a") const {
+      std::string record(qname);
+      record += "\t0\t" + std::string(rname) + "\t1\t255\t";
+      record += this->Cigar() + "\t*\t0\t0\t";
+      record += (this->seq_b.empty() ? "*" : this->seq_b) + "\t*\t";
+      record += "AS:i:" + std::to_string(this->optimal_score);
+      return record;
+    }
+
+   private:
+    std::string Gapped(std::string_view seq, char gap_op) const {
+      std::string result;
+      std::size_t pos = 0;
+      for (const CigarOp &run : this->cigar) {
+        if (run.op == gap_op) {
+          result.append(run.length, '-');
+        } else {
+          result.append(seq.substr(pos, run.length));
+          pos += run.length;
+        }
+      }
+      return result;
+    }
+  };
+
+  template <int Match, int Mismatch, int Gap>
+  struct FixedScoring {
+    static constexpr int match = Match;
+    static constexpr int mismatch = Mismatch;
+    static constexpr int gap = Gap;
+
+    static constexpr bool Equals(const Scoring &scoring) noexcept {
+      return scoring.match == match && scoring.mismatch == mismatch &&
+             scoring.gap == gap;
+    }
+  };
+
+  using Presets = std::tuple<FixedScoring<1, -1, -2>, FixedScoring<2, -1, -2>,
+                             FixedScoring<1, -1, -1>>;
+
   NeedlemanWunsch() = default;
   ~NeedlemanWunsch() = default;
 
-  void SetGapScore(int gap) noexcept { this->gap_ = gap; }
-  void SetMatchScore(int match) noexcept { this->match_ = match; }
-  void SetMismatchScore(int mismatch) noexcept { this->mismatch_ = mismatch; }
+  void SetGapScore(int gap) noexcept { this->scoring_.gap = gap; }
+  void SetMatchScore(int match) noexcept { this->scoring_.match = match; }
+  void SetMismatchScore(int mismatch) noexcept {
+    this->scoring_.mismatch = mismatch;
+  }
 
   void SetSeq(std::string_view seq_a, std::string_view seq_b) noexcept {
     this->seq_a_ = seq_a;
@@ -34,84 +114,281 @@ class NeedlemanWunsch {
   }
 
   void ReadFile(std::string_view path) {
+    S21_METRICS_TIMER("dna_nw_load_ns");
     std::ifstream file(fs::path(path), std::ios::in);
     if (file.is_open()) {
-      file >> this->match_ >> this->mismatch_ >> this->gap_;
+      file >> this->scoring_.match >> this->scoring_.mismatch >>
+          this->scoring_.gap;
       file >> this->seq_a_ >> this->seq_b_;
     }
     file.close();
   }
 
-  inline Sequences GetOptimalAlignment() const { return this->Align(); }
+  inline Sequences GetOptimalAlignment() const {
+    return Align(this->seq_a_, this->seq_b_, this->scoring_);
+  }
+
+  inline Alignment GetAlignment() const {
+    return AlignCigar(this->seq_a_, this->seq_b_, this->scoring_);
+  }
+
+  static Sequences Align(std::string_view seq_a, std::string_view seq_b,
+                         const Scoring &scoring, Arena *arena = nullptr) {
+    return ToSequences(AlignCigar(seq_a, seq_b, scoring, arena));
+  }
+
+  template <int Match, int Mismatch, int Gap>
+  static Sequences Align(std::string_view seq_a, std::string_view seq_b,
+                         FixedScoring<Match, Mismatch, Gap> scoring,
+                         Arena *arena = nullptr) {
+    return ToSequences(AlignPolicy(seq_a, seq_b, scoring, arena));
+  }
+
+  static Alignment AlignCigar(std::string_view seq_a, std::string_view seq_b,
+                              const Scoring &scoring, Arena *arena = nullptr) {
+    return Dispatch(seq_a, seq_b, scoring, arena, Presets{});
+  }
+
+  static Alignment AlignLinear(std::string_view seq_a, std::string_view seq_b,
+                               const Scoring &scoring) {
+    S21_METRICS_TIMER("dna_nw_linear_ns");
+    Alignment result{0, {}, std::string(seq_a), std::string(seq_b)};
+    Hirschberg(seq_a, seq_b, scoring, result.cigar);
+    for (const CigarOp &run : result.cigar) {
+      int step = run.op == '=' ? scoring.match
+                 : run.op == 'X' ? scoring.mismatch
+                                 : scoring.gap;
+      result.optimal_score += step * run.length;
+    }
+    return result;
+  }
+
+  static std::size_t MatrixBytes(std::size_t size_a, std::size_t size_b,
+                                 const Scoring &scoring) noexcept {
+    const std::size_t cell = FitsInt16(size_a, size_b, scoring)
+                                 ? sizeof(std::int16_t)
+                                 : sizeof(int);
+    return (size_a + 1) * (size_b + 1) * cell;
+  }
 
  private:
-  int gap_{};
-  int match_{};
-  int mismatch_{};
+  Scoring scoring_;
   std::string seq_a_;
   std::string seq_b_;
-  mutable Matrix matrix_;
 
-  inline int GetScore(int i, int j) const noexcept {
-    return this->seq_a_[i] == this->seq_b_[j] ? this->match_ : this->mismatch_;
+  static Sequences ToSequences(const Alignment &alignment) {
+    return {alignment.optimal_score, alignment.GappedA(), alignment.GappedB()};
+  }
+
+  template <typename... Fixed>
+  static Alignment Dispatch(std::string_view seq_a, std::string_view seq_b,
+                            const Scoring &scoring, Arena *arena,
+                            std::tuple<Fixed...>) {
+    Alignment result;
+    if (!(TryPreset<Fixed>(seq_a, seq_b, scoring, arena, result) || ...))
+      result = AlignPolicy(seq_a, seq_b, scoring, arena);
+    return result;
   }
 
-  Matrix CreateMatrix() const {
-    std::size_t rows = this->seq_a_.size() + 1;
-    std::size_t cols = this->seq_b_.size() + 1;
-    Matrix new_matrix(rows, std::vector<int>(cols));
+  template <typename Fixed>
+  static bool TryPreset(std::string_view seq_a, std::string_view seq_b,
+                        const Scoring &scoring, Arena *arena,
+                        Alignment &result) {
+    if (!Fixed::Equals(scoring)) return false;
+    result = AlignPolicy(seq_a, seq_b, Fixed{}, arena);
+    return true;
+  }
 
-    for (std::size_t i = 0; i < rows; i++) new_matrix[i][0] = this->gap_ * i;
+  template <typename Policy>
+  static Alignment AlignPolicy(std::string_view seq_a, std::string_view seq_b,
+                               const Policy &scoring, Arena *arena) {
+    if (arena == nullptr) arena = &Arena::ThreadLocal();
+    Arena::Scope scope(*arena);
 
-    for (std::size_t j = 0; j < cols; j++) new_matrix[0][j] = this->gap_ * j;
+    if (FitsInt16(seq_a.size(), seq_b.size(), scoring))
+      return AlignWith<std::int16_t>(seq_a, seq_b, scoring, *arena);
+    return AlignWith<int>(seq_a, seq_b, scoring, *arena);
+  }
 
-    for (std::size_t i = 1; i < rows; i++) {
-      for (std::size_t j = 1; j < cols; j++) {
-        int score_a = new_matrix[i][j - 1] + this->gap_;
-        int score_b = new_matrix[i - 1][j] + this->gap_;
-        int score_c = new_matrix[i - 1][j - 1] + GetScore(i - 1, j - 1);
-        new_matrix[i][j] = std::max({score_a, score_b, score_c});
+  template <typename Policy>
+  static bool FitsInt16(std::size_t size_a, std::size_t size_b,
+                        const Policy &scoring) noexcept {
+    long long step = std::max({std::llabs(scoring.match),
+                               std::llabs(scoring.mismatch),
+                               std::llabs(scoring.gap)});
+    long long bound = step * static_cast<long long>(size_a + size_b + 1);
+    return bound <= std::numeric_limits<std::int16_t>::max();
+  }
+
+  template <typename Policy>
+  static inline int GetScore(std::string_view seq_a, std::string_view seq_b,
+                             int i, int j, const Policy &scoring) noexcept {
+    return seq_a[i - 1] == seq_b[j - 1] ? scoring.match : scoring.mismatch;
+  }
+
+  static void PushOp(std::vector<CigarOp> &cigar, char op, int length = 1) {
+    if (length == 0) return;
+    if (!cigar.empty() && cigar.back().op == op)
+      cigar.back().length += length;
+    else
+      cigar.push_back({op, length});
+  }
+
+  static void Hirschberg(std::string_view seq_a, std::string_view seq_b,
+                         const Scoring &scoring, std::vector<CigarOp> &cigar) {
+    if (seq_a.empty() || seq_b.empty()) {
+      PushOp(cigar, 'D', seq_a.size());
+      PushOp(cigar, 'I', seq_b.size());
+      return;
+    }
+    if (seq_a.size() == 1 || seq_b.size() == 1) {
+      AlignSingle(seq_a, seq_b, scoring, cigar);
+      return;
+    }
+    const std::size_t mid = seq_a.size() / 2;
+    std::vector<int> prefix = LastRow(seq_a.substr(0, mid), seq_b, scoring);
+    std::vector<int> suffix =
+        LastRow(seq_a.substr(mid), seq_b, scoring, true);
+    std::size_t split = 0;
+    int best = std::numeric_limits<int>::min();
+    for (std::size_t k = 0; k <= seq_b.size(); k++) {
+      int score = prefix[k] + suffix[seq_b.size() - k];
+      if (score > best) {
+        best = score;
+        split = k;
       }
     }
-    return new_matrix;
+    Hirschberg(seq_a.substr(0, mid), seq_b.substr(0, split), scoring, cigar);
+    Hirschberg(seq_a.substr(mid), seq_b.substr(split), scoring, cigar);
   }
 
-  Sequences Align() const {
-    this->matrix_ = this->CreateMatrix();
-    std::string alignment_a;
-    std::string alignment_b;
-    int i = this->seq_a_.size();
-    int j = this->seq_b_.size();
+  static void AlignSingle(std::string_view seq_a, std::string_view seq_b,
+                          const Scoring &scoring,
+                          std::vector<CigarOp> &cigar) {
+    const bool single_a = seq_a.size() == 1;
+    std::string_view rest = single_a ? seq_b : seq_a;
+    const char symbol = single_a ? seq_a[0] : seq_b[0];
+    std::size_t best = rest.size();
+    int best_score = 2 * scoring.gap;
+    for (std::size_t k = 0; k < rest.size(); k++) {
+      int score = rest[k] == symbol ? scoring.match : scoring.mismatch;
+      if (score > best_score) {
+        best_score = score;
+        best = k;
+      }
+    }
+    const char gap_op = single_a ? 'I' : 'D';
+    if (best == rest.size()) {
+      PushOp(cigar, single_a ? 'D' : 'I');
+      PushOp(cigar, gap_op, rest.size());
+      return;
+    }
+    PushOp(cigar, gap_op, best);
+    PushOp(cigar, rest[best] == symbol ? '=' : 'X');
+    PushOp(cigar, gap_op, rest.size() - best - 1);
+  }
+
+  static std::vector<int> LastRow(std::string_view seq_a,
+                                  std::string_view seq_b,
+                                  const Scoring &scoring,
+                                  bool reversed = false) {
+    const std::size_t rows = seq_a.size();
+    const std::size_t cols = seq_b.size();
+    std::vector<int> row(cols + 1);
+    for (std::size_t j = 0; j <= cols; j++)
+      row[j] = scoring.gap * static_cast<int>(j);
+    for (std::size_t i = 1; i <= rows; i++) {
+      const char symbol = reversed ? seq_a[rows - i] : seq_a[i - 1];
+      int diag = row[0];
+      row[0] = scoring.gap * static_cast<int>(i);
+      for (std::size_t j = 1; j <= cols; j++) {
+        const char other = reversed ? seq_b[cols - j] : seq_b[j - 1];
+        int up = row[j];
+        row[j] = std::max({diag + (symbol == other ? scoring.match
+                                                   : scoring.mismatch),
+                           up + scoring.gap, row[j - 1] + scoring.gap});
+        diag = up;
+      }
+    }
+    return row;
+  }
+
+  template <typename Cell, typename Policy>
+  static Alignment AlignWith(std::string_view seq_a, std::string_view seq_b,
+                             const Policy &scoring, Arena &arena) {
+    Matrix2D<Cell> matrix = CreateMatrix<Cell>(seq_a, seq_b, scoring, arena);
+    S21_METRICS_TIMER("dna_nw_traceback_ns");
+
+    std::vector<CigarOp> cigar;
+    int i = seq_a.size();
+    int j = seq_b.size();
     while (i > 0 && j > 0) {
-      int score_up = this->matrix_[i][j - 1] + this->gap_;
-      int score_left = this->matrix_[i - 1][j] + this->gap_;
-      int score_diag = this->matrix_[i - 1][j - 1] + GetScore(i - 1, j - 1);
-
-      std::vector<int> same_score;
-      if (this->matrix_[i][j] == score_up)
-        same_score.push_back(this->matrix_[i][j - 1]);
-      if (this->matrix_[i][j] == score_left)
-        same_score.push_back(this->matrix_[i - 1][j]);
-      if (this->matrix_[i][j] == score_diag)
-        same_score.push_back(this->matrix_[i - 1][j - 1]);
-      auto choice = std::max_element(same_score.begin(), same_score.end());
-
-      if (*choice == this->matrix_[i - 1][j - 1]) {
-        alignment_a = this->seq_a_[i - 1] + alignment_a;
-        alignment_b = this->seq_b_[j - 1] + alignment_b;
+      int score_diag =
+          matrix(i - 1, j - 1) + GetScore(seq_a, seq_b, i, j, scoring);
+      int score_up = matrix(i, j - 1) + scoring.gap;
+      int score_left = matrix(i - 1, j) + scoring.gap;
+
+      int current = matrix(i, j);
+      int choice = std::numeric_limits<int>::min();
+      if (current == score_up) choice = std::max<int>(choice, matrix(i, j - 1));
+      if (current == score_left)
+        choice = std::max<int>(choice, matrix(i - 1, j));
+      if (current == score_diag)
+        choice = std::max<int>(choice, matrix(i - 1, j - 1));
+
+      if (choice == matrix(i - 1, j - 1)) {
+        PushOp(cigar, seq_a[i - 1] == seq_b[j - 1] ? '=' : 'X');
         i--;
         j--;
-      } else if (*choice == this->matrix_[i - 1][j]) {
-        alignment_a = this->seq_a_[i - 1] + alignment_a;
-        alignment_b = "-" + alignment_b;
+      } else if (choice == matrix(i - 1, j)) {
+        PushOp(cigar, 'D');
         i--;
-      } else if (*choice == this->matrix_[i][j - 1]) {
-        alignment_a = "-" + alignment_a;
-        alignment_b = this->seq_b_[j - 1] + alignment_b;
+      } else {
+        PushOp(cigar, 'I');
         j--;
       }
     }
-    return {matrix_.back().back(), alignment_a, alignment_b};
+    PushOp(cigar, 'D', i);
+    PushOp(cigar, 'I', j);
+    std::reverse(cigar.begin(), cigar.end());
+    return {matrix(seq_a.size(), seq_b.size()), std::move(cigar),
+            std::string(seq_a), std::string(seq_b)};
+  }
+
+  template <typename Cell, typename Policy>
+  static Matrix2D<Cell> CreateMatrix(std::string_view seq_a,
+                                     std::string_view seq_b,
+                                     const Policy &scoring, Arena &arena) {
+    const std::size_t rows = seq_a.size() + 1;
+    const std::size_t cols = seq_b.size() + 1;
+    S21_METRICS_TIMER("dna_nw_fill_ns");
+    S21_METRICS_COUNT("dna_nw_cells_total", (rows - 1) * (cols - 1));
+    Matrix2D<Cell> matrix(rows, cols, arena);
+
+    const Cell gap = static_cast<Cell>(scoring.gap);
+    const Cell match = static_cast<Cell>(scoring.match);
+    const Cell mismatch = static_cast<Cell>(scoring.mismatch);
+    const char *seq = seq_b.data();
+
+    for (std::size_t i = 0; i < rows; i++) matrix(i, 0) = gap * i;
+
+    for (std::size_t j = 0; j < cols; j++) matrix(0, j) = gap * j;
+
+    for (std::size_t i = 1; i < rows; i++) {
+      Cell *row = matrix[i];
+      const Cell *prev = matrix[i - 1];
+      const char symbol = seq_a[i - 1];
+      for (std::size_t j = 1; j < cols; j++) {
+        Cell score_b = prev[j] + gap;
+        Cell score_c = prev[j - 1] + (seq[j - 1] == symbol ? match : mismatch);
+        row[j] = score_b > score_c ? score_b : score_c;
+      }
+      for (std::size_t j = 1; j < cols; j++) {
+        Cell score_a = row[j - 1] + gap;
+        if (score_a > row[j]) row[j] = score_a;
+      }
+    }
+    return matrix;
   }
 };
 }  // namespace s21
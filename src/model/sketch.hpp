@@ -0,0 +1,115 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_SKETCH_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_SKETCH_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <set>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "kmer_counter.hpp"
+#include "metrics.hpp"
+
+namespace s21 {
+class MinHashSketch {
+ public:
+  static constexpr int kDefaultK = 15;
+  static constexpr std::size_t kDefaultSize = 1000;
+
+  MinHashSketch() = default;
+  ~MinHashSketch() = default;
+
+  static MinHashSketch Build(std::string_view sequence, int k = kDefaultK,
+                             std::size_t size = kDefaultSize) {
+    S21_METRICS_TIMER("dna_sketch_build_ns");
+    MinHashSketch sketch;
+    sketch.k_ = std::clamp(k, 1, KmerEncoding::kMaxK);
+    sketch.size_ = std::max<std::size_t>(size, 1);
+
+    std::set<std::uint64_t> smallest;
+    KmerEncoding::ForEach(sequence, sketch.k_, true, [&](std::uint64_t key) {
+      std::uint64_t hash = KmerEncoding::Hash(key);
+      if (smallest.size() == sketch.size_ && hash >= *smallest.rbegin())
+        return;
+      if (smallest.insert(hash).second && smallest.size() > sketch.size_)
+        smallest.erase(std::prev(smallest.end()));
+    });
+    sketch.hashes_.assign(smallest.begin(), smallest.end());
+    return sketch;
+  }
+
+  int K() const noexcept { return this->k_; }
+  bool Empty() const noexcept { return this->hashes_.empty(); }
+  std::size_t Size() const noexcept { return this->size_; }
+  const std::vector<std::uint64_t> &Hashes() const noexcept {
+    return this->hashes_;
+  }
+
+  double Jaccard(const MinHashSketch &other) const noexcept {
+    if (this->k_ != other.k_) return 0.0;
+    const std::size_t limit = std::min(this->size_, other.size_);
+    std::size_t i = 0, j = 0, seen = 0, shared = 0;
+    while (seen < limit && i < this->hashes_.size() &&
+           j < other.hashes_.size()) {
+      if (this->hashes_[i] == other.hashes_[j]) {
+        shared++;
+        i++;
+        j++;
+      } else if (this->hashes_[i] < other.hashes_[j]) {
+        i++;
+      } else {
+        j++;
+      }
+      seen++;
+    }
+    std::size_t rest = (this->hashes_.size() - i) + (other.hashes_.size() - j);
+    seen = std::min(limit, seen + rest);
+    return seen == 0 ? 0.0 : static_cast<double>(shared) / seen;
+  }
+
+  double MashDistance(const MinHashSketch &other) const noexcept {
+    double jaccard = this->Jaccard(other);
+    if (jaccard <= 0.0) return 1.0;
+    double distance = -std::log(2.0 * jaccard / (1.0 + jaccard)) / this->k_;
+    return std::min(1.0, distance);
+  }
+
+  double Ani(const MinHashSketch &other) const noexcept {
+    return 1.0 - this->MashDistance(other);
+  }
+
+  void Serialize(std::ostream &out) const {
+    out << "MINHASH " << this->k_ << ' ' << this->size_ << ' '
+        << this->hashes_.size() << '\n';
+    for (std::size_t i = 0; i < this->hashes_.size(); i++)
+      out << (i == 0 ? "" : " ") << this->hashes_[i];
+    out << '\n';
+  }
+
+  static bool Deserialize(std::istream &in, MinHashSketch &sketch) {
+    std::string tag;
+    std::size_t count = 0;
+    if (!(in >> tag >> sketch.k_ >> sketch.size_ >> count) ||
+        tag != "MINHASH" || sketch.k_ < 1 ||
+        sketch.k_ > KmerEncoding::kMaxK || sketch.size_ == 0 ||
+        count > sketch.size_)
+      return false;
+    sketch.hashes_.resize(count);
+    for (auto &hash : sketch.hashes_)
+      if (!(in >> hash)) return false;
+    return std::is_sorted(sketch.hashes_.begin(), sketch.hashes_.end());
+  }
+
+ private:
+  int k_{kDefaultK};
+  std::size_t size_{kDefaultSize};
+  std::vector<std::uint64_t> hashes_;
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_SKETCH_HPP_
@@ -0,0 +1,97 @@
+#ifndef A7_DNA_ANALYZER_1_1_MODEL_THREAD_POOL_HPP_
+#define A7_DNA_ANALYZER_1_1_MODEL_THREAD_POOL_HPP_
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace s21 {
+class ThreadPool {
+ public:
+  explicit ThreadPool(std::size_t threads = DefaultThreads()) {
+    if (threads == 0) threads = 1;
+    for (std::size_t i = 0; i < threads; i++)
+      this->workers_.emplace_back([this]() { this->Work(); });
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->stop_ = true;
+    }
+    this->condition_.notify_all();
+    for (auto &worker : this->workers_) worker.join();
+  }
+
+  static std::size_t DefaultThreads() noexcept {
+    std::size_t threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+  }
+
+  std::size_t Size() const noexcept { return this->workers_.size(); }
+
+  template <typename Func>
+  auto Submit(Func func) -> std::future<std::invoke_result_t<Func>> {
+    using Result = std::invoke_result_t<Func>;
+    auto task = std::make_shared<std::packaged_task<Result()>>(std::move(func));
+    std::future<Result> result = task->get_future();
+    {
+      std::lock_guard<std::mutex> lock(this->mutex_);
+      this->tasks_.emplace([task]() { (*task)(); });
+    }
+    this->condition_.notify_one();
+    return result;
+  }
+
+ private:
+  bool stop_{};
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::queue<std::function<void()>> tasks_;
+  std::vector<std::thread> workers_;
+
+  void Work() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(this->mutex_);
+        this->condition_.wait(
+            lock, [this]() { return this->stop_ || !this->tasks_.empty(); });
+        if (this->stop_ && this->tasks_.empty()) return;
+        task = std::move(this->tasks_.front());
+        this->tasks_.pop();
+      }
+      task();
+    }
+  }
+};
+
+template <typename Func>
+void RunInThreads(std::size_t threads, Func func) {
+  std::vector<std::thread> workers;
+  for (std::size_t t = 1; t < threads; t++) workers.emplace_back(func, t);
+  func(std::size_t{0});
+  for (auto &worker : workers) worker.join();
+}
+
+template <typename Func>
+void ForEachRange(std::size_t count, std::size_t threads, Func func) {
+  threads = std::max<std::size_t>(std::min(threads, count), 1);
+  RunInThreads(threads, [&](std::size_t t) {
+    func(count * t / threads, count * (t + 1) / threads);
+  });
+}
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_MODEL_THREAD_POOL_HPP_
@@ -2,18 +2,24 @@
 #define A7_DNA_ANALYZER_1_1_MODEL_WINDOW_SUBSTRING_HPP_
 
 #include <algorithm>
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <limits>
 #include <string>
 #include <string_view>
-#include <vector>
+#include <utility>
+
+#include "metrics.hpp"
+#include "thread_pool.hpp"
 
 namespace fs = std::filesystem;
 
 namespace s21 {
 class WindowSubstring {
  public:
+  using StringPair = std::pair<std::string_view, std::string_view>;
+
   WindowSubstring() = default;
   ~WindowSubstring() = default;
 
@@ -30,17 +36,40 @@ class WindowSubstring {
   }
 
   std::string GetMinimumWindowSubstring() const {
-    if (this->pattern_.size() > this->str_.size()) return "";
+    return GetMinimumWindowSubstring(this->str_, this->pattern_);
+  }
+
+  static std::string GetMinimumWindowSubstring(std::string_view str,
+                                               std::string_view pattern) {
+    return std::string(FindWindow(str, pattern));
+  }
+
+  static void GetMinimumWindowSubstrings(
+      const StringPair *pairs, std::size_t count, std::string_view *results,
+      std::size_t threads = ThreadPool::DefaultThreads()) {
+    ForEachRange(count, threads, [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; i++)
+        results[i] = FindWindow(pairs[i].first, pairs[i].second);
+    });
+  }
+
+  static std::string_view FindWindow(std::string_view str,
+                                     std::string_view pattern) noexcept {
+    S21_METRICS_TIMER("dna_ws_search_ns");
+    if (pattern.empty() || pattern.size() > str.size()) return {};
 
-    std::vector<int> let_count(128, 0);
-    for (auto ch : this->pattern_) let_count[ch]++;
+    std::array<int, 256> let_count{};
+    for (unsigned char ch : pattern) let_count[ch]++;
 
-    int min_len = __INT_MAX__;
+    int min_len = std::numeric_limits<int>::max();
     int begin = 0, end = 0, head = 0;
-    int counter = this->pattern_.size();
+    int counter = pattern.size();
+    auto symbol = [str](int pos) {
+      return static_cast<unsigned char>(str[pos]);
+    };
 
-    while (static_cast<std::size_t>(end) < this->str_.size()) {
-      if (let_count[this->str_[end++]]-- > 0) counter--;
+    while (static_cast<std::size_t>(end) < str.size()) {
+      if (let_count[symbol(end++)]-- > 0) counter--;
 
       while (counter == 0) {
         if (end - begin < min_len) {
@@ -48,12 +77,12 @@ class WindowSubstring {
           min_len = end - begin;
         }
 
-        if (let_count[this->str_[begin++]]++ == 0) counter++;
+        if (let_count[symbol(begin++)]++ == 0) counter++;
       }
     }
-    return min_len == __INT_MAX__
-               ? ""
-               : std::string(this->str_.substr(head, min_len));
+    return min_len == std::numeric_limits<int>::max()
+               ? std::string_view()
+               : str.substr(head, min_len);
   }
 
  private:
@@ -1,6 +1,7 @@
 #ifndef A7_DNA_ANALYZER_1_1_VIEW_CONSOLE_VIEW_HPP_
 #define A7_DNA_ANALYZER_1_1_VIEW_CONSOLE_VIEW_HPP_
 
+#include <algorithm>
 #include <filesystem>
 #include <functional>
 #include <iostream>
@@ -190,7 +191,7 @@ class ConsoleView {
 
   void AlgorithmRK() {
     std::string text, pattern;
-    int opt = -1;
+    int opt = -1, limit = 0;
     while (opt != 0 && opt != 1 && opt != 2) {
       std::cout << BOLD << BLUE << "TEXT:\n" << RESET << std::endl;
       std::cout << RED << "1. " << BLUE << "Enter text" << RESET << std::endl;
@@ -235,14 +236,71 @@ class ConsoleView {
                     << RESET << std::endl;
         }
       }
+      if (opt != 0 && !pattern.empty()) {
+        opt = -1;
+        this->ClearOutput();
+        while (opt < 0 || opt > 5) {
+          std::cout << BOLD << BLUE << "SEARCH MODE:\n" << RESET << std::endl;
+          std::cout << RED << "1. " << BLUE << "Forward strand" << RESET
+                    << std::endl;
+          std::cout << RED << "2. " << BLUE
+                    << "Both strands (with reverse complement)" << RESET
+                    << std::endl;
+          std::cout << RED << "3. " << BLUE << "Only check if pattern occurs"
+                    << RESET << std::endl;
+          std::cout << RED << "4. " << BLUE << "Only count occurrences"
+                    << RESET << std::endl;
+          std::cout << RED << "5. " << BLUE << "First N positions" << RESET
+                    << std::endl;
+          std::cout << RED << "0. " << BLUE << "Cancel" << RESET << std::endl;
+          std::cout << GREEN << "\nSelect menu item: " << RESET;
+          opt = GetCorrectInt();
+          if (opt < 0 || opt > 5)
+            std::cout << BOLD << RED
+                      << "\nERROR: This item is not on the menu!\n"
+                      << RESET << std::endl;
+        }
+        if (opt == 5) {
+          std::cout << GREEN << "\nEnter N: " << RESET;
+          limit = GetCorrectInt();
+        }
+      }
       if (opt != 0 && !pattern.empty()) {
         this->ClearOutput();
         std::cout << RED << "Text: " << BLUE << text << std::endl;
         std::cout << RED << "Pattern: " << BLUE << pattern << std::endl;
 
-        std::list<int> res = controller_.AlgorithmRK(text, pattern);
-        std::cout << RED << "Positions: " << RESET;
-        for (auto pos : res) std::cout << GREEN << pos << " ";
+        try {
+          if (opt == 3) {
+            auto res = controller_.AlgorithmRKQuery(
+                text, pattern, RabinKarp::QueryMode::kExists);
+            std::cout << RED << "Occurs: " << GREEN
+                      << (res.count > 0 ? "yes" : "no");
+          } else if (opt == 4) {
+            auto res = controller_.AlgorithmRKQuery(
+                text, pattern, RabinKarp::QueryMode::kCount);
+            std::cout << RED << "Occurrences: " << GREEN << res.count;
+          } else {
+            std::cout << RED << "Positions: " << RESET;
+          }
+          if (opt == 1 || opt == 5) {
+            std::list<int> res =
+                opt == 1 ? controller_.AlgorithmRK(text, pattern)
+                         : controller_.AlgorithmRKQuery(
+                               text, pattern, RabinKarp::QueryMode::kFirstN,
+                               std::max(limit, 0))
+                               .positions;
+            for (auto pos : res) std::cout << GREEN << pos << " ";
+          } else if (opt == 2) {
+            std::list<StrandHit> res =
+                controller_.AlgorithmRKBothStrands(text, pattern);
+            for (auto [pos, strand] : res)
+              std::cout << GREEN << pos
+                        << (strand == Strand::kForward ? "(+) " : "(-) ");
+          }
+        } catch (const std::exception &error) {
+          std::cout << BOLD << RED << "\nERROR: " << error.what();
+        }
         std::cout << RESET << std::endl << std::endl;
       }
     }
@@ -282,21 +340,22 @@ class ConsoleView {
     }
     if (opt != 0) {
       this->ClearOutput();
-      Controller::Sequences res;
+      Controller::Alignment res;
       if (opt == 1 && !seq_a.empty() && !seq_b.empty())
-        res = controller_.AlgorithmNW(gap, match, mismatch, seq_a, seq_b);
+        res = controller_.AlgorithmNWCigar(gap, match, mismatch, seq_a, seq_b);
       else if (opt == 2 && !path.empty())
-        res = controller_.AlgorithmNW(path);
+        res = controller_.AlgorithmNWCigar(path);
 
-      auto [score, str_a, str_b] = res;
       std::cout << std::endl
-                << RED << "Optimal score:\t" << GREEN << score << std::endl;
+                << RED << "Optimal score:\t" << GREEN << res.optimal_score
+                << std::endl;
+      std::cout << RED << "CIGAR:\t\t" << GREEN << res.Cigar() << std::endl;
       std::cout << RED << "Optimal align:\t";
-      std::cout << GREEN << str_a << BLUE << std::endl << "\t\t";
-      for (std::size_t i = 0; i < str_a.size(); i++)
-        std::cout << ((str_a[i] == str_b[i]) ? "|" : " ");
+      std::cout << GREEN << res.GappedA() << BLUE << std::endl << "\t\t";
+      for (const auto &run : res.cigar)
+        std::cout << std::string(run.length, run.op == '=' ? '|' : ' ');
       std::cout << std::endl
-                << GREEN << "\t\t" << str_b << RESET << std::endl
+                << GREEN << "\t\t" << res.GappedB() << RESET << std::endl
                 << std::endl;
     }
   }
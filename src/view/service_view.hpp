@@ -0,0 +1,134 @@
+#ifndef A7_DNA_ANALYZER_1_1_VIEW_SERVICE_VIEW_HPP_
+#define A7_DNA_ANALYZER_1_1_VIEW_SERVICE_VIEW_HPP_
+
+#include <iostream>
+#include <list>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "../controller/controller.hpp"
+#include "../controller/query_service.hpp"
+#include "../model/metrics.hpp"
+
+namespace s21 {
+class ServiceView {
+ public:
+  using Algorithm = QueryService::Algorithm;
+
+  explicit ServiceView(const Controller *controller = nullptr,
+                       std::size_t threads = ThreadPool::DefaultThreads())
+      : controller_(controller), service_(threads) {
+    algorithms_["rk"] = Algorithm::kRabinKarp;
+    algorithms_["nw"] = Algorithm::kNeedlemanWunsch;
+    algorithms_["rg"] = Algorithm::kRegex;
+    algorithms_["ks"] = Algorithm::kKStrings;
+    algorithms_["ws"] = Algorithm::kWindowSubstring;
+    algorithms_["km"] = Algorithm::kKmers;
+  }
+
+  ~ServiceView() = default;
+
+  void RunService(std::istream &in = std::cin, std::ostream &out = std::cout) {
+    std::string line;
+    while (std::getline(in, line)) {
+      std::istringstream stream(line);
+      std::string command;
+      stream >> command;
+
+      auto algorithm = this->algorithms_.find(command);
+      if (algorithm != this->algorithms_.end()) {
+        QueryService::Request request{this->next_id_++, algorithm->second, {}};
+        for (std::string arg; stream >> arg;) request.args.push_back(arg);
+        this->batch_.push_back(std::move(request));
+        if (this->batch_.size() >= kMaxBatchSize ||
+            in.rdbuf()->in_avail() <= 0)
+          this->Flush(out);
+        continue;
+      }
+
+      this->Flush(out);
+      if (command == "load") {
+        std::string name, path;
+        stream >> name >> path;
+        out << "load " << name << " "
+            << (this->service_.LoadReference(name, path) ? "ok" : "error")
+            << std::endl;
+      } else if (command == "shard") {
+        this->Shard(stream, out);
+      } else if (command == "help") {
+        out << kHelp << std::flush;
+      } else if (command == "stats") {
+        auto stats = this->service_.GetLatencyStats();
+        out << "stats count=" << stats.count << " p50_us=" << stats.p50_us
+            << " p99_us=" << stats.p99_us << std::endl;
+      } else if (command == "metrics") {
+        out << Metrics::Instance().ToPrometheus() << std::flush;
+      } else if (command == "quit") {
+        return;
+      } else if (!command.empty()) {
+        out << "error unknown command " << command << std::endl;
+      }
+    }
+    this->Flush(out);
+  }
+
+ private:
+  static constexpr std::size_t kMaxBatchSize = 1024;
+  static constexpr std::string_view kHelp =
+      "rk <text> <pattern>\n"
+      "nw <match> <mismatch> <gap> <seq_a> <seq_b>\n"
+      "rg <text> <expression>\n"
+      "ks <str_a> <str_b>\n"
+      "ws <text> <pattern>\n"
+      "km <text> <k> <top_n>\n"
+      "  any text argument may be @name of a loaded reference\n"
+      "load <name> <path>\n"
+      "shard <exact|iupac|mismatch|edit> <max_errors> <pattern>\n"
+      "stats | metrics | help | quit\n";
+
+  const Controller *controller_;
+  QueryService service_;
+  std::size_t next_id_{};
+  std::vector<QueryService::Request> batch_;
+  std::map<std::string, Algorithm> algorithms_;
+
+  void Shard(std::istream &stream, std::ostream &out) const {
+    static const std::map<std::string, ShardCoordinator::Engine> engines = {
+        {"exact", ShardCoordinator::Engine::kExact},
+        {"iupac", ShardCoordinator::Engine::kIupac},
+        {"mismatch", ShardCoordinator::Engine::kMismatch},
+        {"edit", ShardCoordinator::Engine::kEdit}};
+    std::string engine, pattern;
+    int max_errors = 0;
+    stream >> engine >> max_errors >> pattern;
+    auto found = engines.find(engine);
+    std::optional<std::list<ShardCoordinator::Hit>> hits;
+    if (this->controller_ != nullptr && found != engines.end())
+      hits = this->controller_->AlgorithmShardSearch(pattern, found->second,
+                                                     max_errors);
+    if (!hits) {
+      out << "shard error" << std::endl;
+      return;
+    }
+    out << "shard ok";
+    for (const auto &hit : *hits)
+      out << ' ' << hit.position << ':' << hit.distance;
+    out << std::endl;
+  }
+
+  void Flush(std::ostream &out) {
+    if (this->batch_.empty()) return;
+    for (const auto &response : this->service_.Process(this->batch_))
+      out << response.id << (response.ok ? " ok " : " error ")
+          << response.result << '\n';
+    out.flush();
+    this->batch_.clear();
+  }
+};
+}  // namespace s21
+
+#endif  // A7_DNA_ANALYZER_1_1_VIEW_SERVICE_VIEW_HPP_
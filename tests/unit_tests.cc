@@ -1,10 +1,23 @@
 #include "gtest/gtest.h"
 
 #include "../src/model/regex.hpp"
+#include "../src/model/regex_program.hpp"
+#include "../src/model/sketch.hpp"
+#include "../src/controller/controller.hpp"
+#include "../src/model/kmer_counter.hpp"
+#include "../src/model/approximate_search.hpp"
+#include "../src/model/matrix.hpp"
+#include "../src/model/large_pages.hpp"
+#include "../src/model/metrics.hpp"
 #include "../src/model/k_strings.hpp"
 #include "../src/model/dna_search.hpp"
+#include "../src/model/incremental_search.hpp"
+#include "../src/model/iupac_search.hpp"
 #include "../src/model/window_substring.hpp"
 #include "../src/model/sequence_alignment.hpp"
+#include "../src/controller/query_service.hpp"
+#include "../src/controller/shard_coordinator.hpp"
+#include "../src/controller/job_runner.hpp"
 
 TEST(RabinKarpTest, BasicSearch) {
     s21::RabinKarp rk;
@@ -26,6 +39,81 @@ TEST(RabinKarpTest, SearchWithFile) {
     ASSERT_EQ(positions.back(), 9150);
 }
 
+TEST(RabinKarpTest, PrefetchedFileSearchAcrossChunks) {
+    for (std::size_t threads : {1, 3}) {
+        std::list<int> positions = s21::RabinKarp::SearchFile(
+            "../datasets/dna_search_text.txt", "AAGCCTCAATAAAGCTT", threads, 70);
+        ASSERT_EQ(positions, std::list<int>({65, 9150}));
+    }
+    ASSERT_TRUE(s21::RabinKarp::SearchFile("../datasets/missing.txt", "ACGT").empty());
+    if (s21::MappedFile::FileSize("../datasets") > 0) {
+        ASSERT_THROW(s21::RabinKarp::SearchFile("../datasets", "ACGT"), std::ios_base::failure);
+    }
+}
+
+TEST(RabinKarpTest, BothStrandsSinglePass) {
+    ASSERT_EQ(s21::RabinKarp::ReverseComplement("AACGTN"), "NACGTT");
+    std::list<s21::StrandHit> hits = s21::RabinKarp::SearchBothStrands("GGAACTTTAGTTCC", "AACT");
+    std::list<s21::StrandHit> expected = {
+        {2, s21::Strand::kForward}, {8, s21::Strand::kReverse}};
+    ASSERT_EQ(hits, expected);
+
+    hits = s21::RabinKarp::SearchBothStrands("TTACGTAA", "ACGT");
+    expected = {{2, s21::Strand::kForward}, {2, s21::Strand::kReverse}};
+    ASSERT_EQ(hits, expected);
+
+    auto file_hits = s21::RabinKarp::SearchFileBothStrands(
+        "../datasets/dna_search_text.txt", "AAGCTTTATTGAGGCTT", 2, 64);
+    expected = {{65, s21::Strand::kReverse}, {9150, s21::Strand::kReverse}};
+    ASSERT_EQ(file_hits, expected);
+}
+
+TEST(RabinKarpTest, AlphabetSpecializedScan) {
+    ASSERT_EQ(s21::Dna5Alphabet::Code('t'), 3);
+    ASSERT_TRUE(s21::Dna5Alphabet::Covers("ACGNn"));
+    ASSERT_FALSE(s21::Dna5Alphabet::Covers("ACGR"));
+    ASSERT_EQ(s21::IupacAlphabet::Code('N'), 15);
+    ASSERT_EQ(s21::RabinKarp::Search("acgtACGTacgt", "ACGT"), std::list<int>({4}));
+    ASSERT_EQ(s21::RabinKarp::Search("ACGNACGT", "CGN"), std::list<int>({1}));
+    ASSERT_EQ(s21::RabinKarp::Search("CGRCGNcgn", "CGN"), std::list<int>({3}));
+}
+
+TEST(RabinKarpTest, IncrementalEdits) {
+    s21::IncrementalSearch search("ACGTTACGTAACG", "ACG");
+    ASSERT_EQ(search.Positions(), std::vector<std::size_t>({0, 5, 10}));
+    search.Replace(6, 1, "T");
+    ASSERT_EQ(search.Positions(), std::vector<std::size_t>({0, 10}));
+    search.Insert(2, "ACG");
+    ASSERT_EQ(search.Positions(), std::vector<std::size_t>({2, 13}));
+    search.Erase(0, 4);
+    ASSERT_EQ(search.Text(), "GGTTATGTAACG");
+    ASSERT_EQ(search.Positions(), std::vector<std::size_t>({9}));
+    search.Erase(10, 1);
+    ASSERT_TRUE(search.Positions().empty());
+
+    s21::Controller controller;
+    ASSERT_EQ(controller.StartIncrementalRK("ACGTTACGT", "ACG"), std::vector<std::size_t>({0, 5}));
+    ASSERT_EQ(controller.AlgorithmRKEdit(3, 1, "TT"), std::vector<std::size_t>({0, 6}));
+    ASSERT_EQ(controller.AlgorithmRKEdit(4, 2, "A"), std::vector<std::size_t>({0, 5}));
+}
+
+TEST(RabinKarpTest, ExistsCountAndFirstN) {
+    std::string text;
+    for (int i = 0; i < 50000; i++) text += "ACGTTGCA";
+    for (std::size_t threads : {1, 4}) {
+        ASSERT_TRUE(s21::RabinKarp::Exists(text, "TTGC", threads));
+        ASSERT_FALSE(s21::RabinKarp::Exists(text, "AAAA", threads));
+        ASSERT_EQ(s21::RabinKarp::Count(text, "GCAA", threads), 49999);
+        ASSERT_EQ(s21::RabinKarp::FirstN(text, "CGT", 3, threads), std::list<int>({1, 9, 17}));
+    }
+    s21::RabinKarp rk;
+    rk.SetText("../datasets/dna_search_text.txt");
+    rk.SetPattern("AAGCCTCAATAAAGCTT");
+    ASSERT_TRUE(rk.Exists());
+    ASSERT_EQ(rk.Count(), 2);
+    ASSERT_EQ(rk.FirstN(1), std::list<int>({65}));
+}
+
 TEST(RabinKarpTest, EmptySearch) {
     s21::RabinKarp rk;
     rk.SetText("abcde");
@@ -34,6 +122,124 @@ TEST(RabinKarpTest, EmptySearch) {
     ASSERT_TRUE(positions.empty());
 }
 
+TEST(IupacSearchTest, DegenerateBases) {
+    s21::Controller controller;
+    ASSERT_EQ(controller.AlgorithmIupac("AGTTAACGTTAGGTCAGCTN", "RGYT"), std::list<int>({0, 15}));
+    ASSERT_EQ(controller.AlgorithmIupac("acgu", "NNNT"), std::list<int>({0}));
+    ASSERT_TRUE(controller.AlgorithmIupac("ACGT", "AXGT").empty());
+
+    std::string text(100000, 'C');
+    std::string primer = std::string(70, 'S') + "WN";
+    text.replace(1000, 72, std::string(70, 'G') + "TA");
+    ASSERT_EQ(s21::IupacSearch::Search(text, primer, 4), std::list<int>({1000}));
+}
+
+TEST(ApproximateSearchTest, KMismatch) {
+    using Hit = s21::ApproximateHit;
+    auto hits = s21::ApproximateSearch::Search("ACGTTCGTACGA", "ACGT", 1);
+    ASSERT_EQ(hits, std::list<Hit>({{0, 0}, {4, 1}, {8, 1}}));
+    ASSERT_TRUE(s21::ApproximateSearch::Search("AAAA", "CCC", 2).empty());
+}
+
+TEST(ApproximateSearchTest, KEditFindsIndels) {
+    using Mode = s21::ApproximateSearch::Mode;
+    auto hits = s21::ApproximateSearch::Search("TTTGGCGACACTCCTTT", "GGCGAACACTCC", 1, Mode::kEdit);
+    ASSERT_FALSE(hits.empty());
+    ASSERT_EQ(hits.front().position, 3);
+    ASSERT_EQ(hits.front().distance, 1);
+    for (const auto &hit : hits) ASSERT_LE(hit.distance, 1);
+    ASSERT_TRUE(s21::ApproximateSearch::Search("TTTTTTTTTTTT", "GGCGAACACTCC", 2, Mode::kEdit).empty());
+    hits = s21::ApproximateSearch::Search("AC", "GGG", 3, Mode::kEdit);
+    ASSERT_EQ(hits.size(), 2U);
+    ASSERT_EQ(hits.back().position, 1);
+    ASSERT_TRUE(s21::ApproximateSearch::Search("", "GGG", 3, Mode::kEdit).empty());
+}
+
+TEST(KmerCounterTest, CanonicalCountsHistogramAndTopN) {
+    s21::KmerCounter counter(3);
+    counter.Count("ACGTTACGNACG", 2);
+    ASSERT_EQ(counter.Total(), 7U);
+    ASSERT_EQ(counter.GetCount("ACG"), 4U);
+    ASSERT_EQ(counter.GetCount("CGT"), 4U);
+    ASSERT_EQ(counter.GetCount("TTA"), 1U);
+    ASSERT_EQ(counter.GetCount("TAA"), 1U);
+    ASSERT_EQ(counter.GetCount("GGG"), 0U);
+    ASSERT_EQ(counter.Distinct(), 4U);
+    ASSERT_EQ(counter.Histogram(), (std::map<std::uint64_t, std::uint64_t>{{1, 3}, {4, 1}}));
+    std::vector<s21::KmerCounter::KmerCount> top = {{"ACG", 4}};
+    ASSERT_EQ(counter.TopN(1), top);
+}
+
+TEST(KmerCounterTest, ThreadedAndSketchModesAgree) {
+    std::ifstream file("../datasets/dna_search_text.txt");
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    s21::KmerCounter single(11, false), threaded(11, false);
+    single.Count(text, 1);
+    threaded.Count(text, 4);
+    ASSERT_EQ(single.Histogram(), threaded.Histogram());
+    ASSERT_EQ(single.TopN(5), threaded.TopN(5));
+
+    s21::KmerCounter sketch(11, false, s21::KmerCounter::Mode::kSketch, 1 << 12, 4);
+    sketch.Count(text, 2);
+    for (const auto &[kmer, count] : single.TopN(20))
+        ASSERT_GE(sketch.GetCount(kmer), count);
+    ASSERT_THROW(sketch.Histogram(), std::logic_error);
+    ASSERT_THROW(sketch.Distinct(), std::logic_error);
+    ASSERT_THROW(sketch.TopN(s21::KmerCounter::kDefaultHeavyHitters + 1), std::invalid_argument);
+
+    s21::KmerCounter tracked(11, false, s21::KmerCounter::Mode::kSketch, 1 << 16, 4, 64);
+    tracked.Count(text.substr(0, text.size() / 2), 2);
+    tracked.Count(text.substr(text.size() / 2 - 10), 2);
+    auto heavy = tracked.TopN(5);
+    ASSERT_EQ(heavy.size(), 5U);
+    ASSERT_EQ(s21::Controller().AlgorithmKmers(text, 11, false).TopN(5), single.TopN(5));
+    auto exact = single.TopN(5);
+    for (std::size_t i = 0; i < heavy.size(); i++) ASSERT_EQ(heavy[i].count, exact[i].count);
+}
+
+TEST(MinHashSketchTest, SimilarityAndSerialization) {
+    std::ifstream file("../datasets/dna_search_text.txt");
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    std::string mutated = text;
+    for (std::size_t i = 100; i < mutated.size(); i += 500) mutated[i] = mutated[i] == 'A' ? 'C' : 'A';
+
+    auto sketch = s21::MinHashSketch::Build(text, 15, 500);
+    ASSERT_DOUBLE_EQ(sketch.Jaccard(sketch), 1.0);
+    ASSERT_DOUBLE_EQ(sketch.Ani(sketch), 1.0);
+    double ani = sketch.Ani(s21::MinHashSketch::Build(mutated, 15, 500));
+    ASSERT_GT(ani, 0.99);
+    ASSERT_LT(ani, 1.0);
+    ASSERT_LT(sketch.Ani(s21::MinHashSketch::Build("ACACACACACACACACACACAC", 15, 500)), 0.5);
+
+    std::stringstream stream;
+    sketch.Serialize(stream);
+    s21::MinHashSketch restored;
+    ASSERT_TRUE(s21::MinHashSketch::Deserialize(stream, restored));
+    ASSERT_EQ(restored.Hashes(), sketch.Hashes());
+    ASSERT_DOUBLE_EQ(restored.Jaccard(sketch), 1.0);
+
+    std::stringstream bad_k("MINHASH 40 10 0\n"), bad_count("MINHASH 15 2 3\n1 2 3\n");
+    ASSERT_FALSE(s21::MinHashSketch::Deserialize(bad_k, restored));
+    ASSERT_FALSE(s21::MinHashSketch::Deserialize(bad_count, restored));
+}
+
+TEST(NeedlemanWunschTest, BatchSkipsDissimilarPairs) {
+    s21::Controller controller;
+    auto results = controller.AlgorithmNWBatch(
+        {{"AGTACGTTAGCA", "AGTACGTTAGCA"}, {"AGTACGTTAGCA", "CCCCCCCCCCCC"}, {"ACG", "ACG"}},
+        -2, 2, -1, 0.8, 5);
+    ASSERT_TRUE(results[0].has_value());
+    ASSERT_EQ(results[0]->optimal_score, 24);
+    ASSERT_FALSE(results[1].has_value());
+    ASSERT_TRUE(results[2].has_value());
+
+    auto sketch = s21::MinHashSketch::Build("AGTACGTTAGCA", 5);
+    auto poly_c = s21::MinHashSketch::Build("CCCCCCCCCCCC", 5);
+    results = controller.AlgorithmNWBatch({{"AGTACGTTAGCA", "CCCCCCCCCCCC"}},
+                                          {{&sketch, &poly_c}}, -2, 2, -1, 0.8);
+    ASSERT_FALSE(results[0].has_value());
+}
+
 TEST(NeedlemanWunschTest, ExampleTest) {
     s21::NeedlemanWunsch nw;
     nw.SetMatchScore(2);
@@ -55,6 +261,108 @@ TEST(NeedlemanWunschTest, FileInputTest) {
     ASSERT_EQ(result.alignment_b, "GG-CGACAC-CCACCATACAT");
 }
 
+TEST(NeedlemanWunschTest, ReentrantWithArena) {
+    s21::Arena arena;
+    for (int i = 0; i < 3; i++) {
+        auto result = s21::NeedlemanWunsch::Align("AGTACG", "AGCTCG", {2, -1, -2}, &arena);
+        ASSERT_EQ(result.optimal_score, 6);
+        ASSERT_EQ(result.alignment_a, "AG-TACG");
+        ASSERT_EQ(result.alignment_b, "AGCT-CG");
+    }
+    std::size_t capacity = arena.Capacity();
+    s21::NeedlemanWunsch::Align("AGTACG", "AGCTCG", {2, -1, -2}, &arena);
+    ASSERT_EQ(arena.Capacity(), capacity);
+
+    {
+        s21::Arena::Scope scope(arena);
+        arena.Allocate<char>(capacity);
+        arena.Allocate<char>(4 * capacity);
+        ASSERT_GT(arena.Capacity(), 5 * capacity);
+    }
+    ASSERT_GT(arena.Capacity(), 4 * capacity);
+    ASSERT_LT(arena.Capacity(), 5 * capacity);
+}
+
+TEST(NeedlemanWunschTest, WideScoresUseInt32Cells) {
+    auto result = s21::NeedlemanWunsch::Align("AGTACG", "AGCTCG", {20000, -10000, -20000});
+    ASSERT_EQ(result.optimal_score, 60000);
+    ASSERT_EQ(result.alignment_a, "AG-TACG");
+    ASSERT_EQ(result.alignment_b, "AGCT-CG");
+}
+
+TEST(NeedlemanWunschTest, CigarAndSamOutput) {
+    auto alignment = s21::NeedlemanWunsch::AlignCigar("GGGCGACACTCCACCATAGA", "GGCGACACCCACCATACAT", {1, -1, -2});
+    ASSERT_EQ(alignment.Cigar(), "2=1D6=1D8=1X1=1I");
+    ASSERT_EQ(alignment.GappedA(), "GGGCGACACTCCACCATAGA-");
+    ASSERT_EQ(alignment.GappedB(), "GG-CGACAC-CCACCATACAT");
+    ASSERT_EQ(alignment.ToSam("read", "ref"),
+              "read\t0\tref\t1\t255\t2=1D6=1D8=1X1=1I\t*\t0\t0\tGGCGACACCCACCATACAT\t*\tAS:i:10");
+
+    alignment = s21::NeedlemanWunsch::AlignCigar("TTACG", "ACG", {1, -1, -1});
+    ASSERT_EQ(alignment.GappedA().size(), alignment.GappedB().size());
+    ASSERT_EQ(alignment.GappedB(), "--ACG");
+    ASSERT_EQ(alignment.cigar.front(), (s21::NeedlemanWunsch::CigarOp{'D', 2}));
+}
+
+TEST(NeedlemanWunschTest, LinearSpaceMatchesFullMatrix) {
+    std::string seq_a = "GGGCGACACTCCACCATAGAACGTTAGC";
+    std::string seq_b = "GGCGACACCCACCATACATTTAGGC";
+    for (s21::NeedlemanWunsch::Scoring scoring : {s21::NeedlemanWunsch::Scoring{1, -1, -2},
+                                                  s21::NeedlemanWunsch::Scoring{3, -2, -1}}) {
+        auto linear = s21::NeedlemanWunsch::AlignLinear(seq_a, seq_b, scoring);
+        ASSERT_EQ(linear.optimal_score, s21::NeedlemanWunsch::AlignCigar(seq_a, seq_b, scoring).optimal_score);
+        std::string gapped_a = linear.GappedA(), gapped_b = linear.GappedB();
+        gapped_a.erase(std::remove(gapped_a.begin(), gapped_a.end(), '-'), gapped_a.end());
+        gapped_b.erase(std::remove(gapped_b.begin(), gapped_b.end(), '-'), gapped_b.end());
+        ASSERT_EQ(gapped_a, seq_a);
+        ASSERT_EQ(gapped_b, seq_b);
+    }
+}
+
+TEST(NeedlemanWunschTest, FixedScoringMatchesRuntime) {
+    using Fixed = s21::NeedlemanWunsch::FixedScoring<3, -2, -4>;
+    auto fixed = s21::NeedlemanWunsch::Align("GGGCGACACTCCACCATAGA", "GGCGACACCCACCATACAT", Fixed{});
+    auto runtime = s21::NeedlemanWunsch::Align("GGGCGACACTCCACCATAGA", "GGCGACACCCACCATACAT", {3, -2, -4});
+    ASSERT_EQ(fixed.optimal_score, runtime.optimal_score);
+    ASSERT_EQ(fixed.alignment_a, runtime.alignment_a);
+    ASSERT_EQ(fixed.alignment_b, runtime.alignment_b);
+    using Preset = s21::NeedlemanWunsch::FixedScoring<2, -1, -2>;
+    ASSERT_EQ(s21::NeedlemanWunsch::Align("AGTACG", "AGCTCG", Preset{}).alignment_a, "AG-TACG");
+}
+
+TEST(LargePagesTest, AllocatorBacksBigBuffers) {
+    s21::LargeString text(3 << 20, 'A');
+    text[(3 << 20) - 1] = 'C';
+    ASSERT_EQ(s21::RabinKarp::Search(text, "AAC"), std::list<int>({(3 << 20) - 3}));
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(text.data()) % 64, 0U);
+
+    s21::LargePages::Policy interleave{s21::LargePages::Numa::kInterleave, 0};
+    std::vector<int, s21::LargePageAllocator<int>> numbers(1 << 20, 7, s21::LargePageAllocator<int>(interleave));
+    ASSERT_EQ(numbers.back(), 7);
+    s21::Matrix2D<int> matrix(1024, 1024);
+    matrix(1023, 1023) = 5;
+    ASSERT_EQ(matrix[1023][1023], 5);
+}
+
+TEST(MatrixTest, AlignedContiguousRows) {
+    s21::Arena arena;
+    s21::Matrix2D<std::int16_t> matrix(3, 5, arena);
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(matrix[1]) % s21::kRowAlignment, 0U);
+    ASSERT_EQ(matrix[1] - matrix[0], static_cast<std::ptrdiff_t>(matrix.Stride()));
+    matrix(2, 4) = 7;
+    ASSERT_EQ(matrix[2][4], 7);
+
+    s21::BitMatrix bits(2, 130, arena);
+    ASSERT_EQ(bits.Words(), 3U);
+    ASSERT_FALSE(bits.Get(0, 5));
+    bits.Set(1, 129, true);
+    ASSERT_TRUE(bits.Get(1, 129));
+    ASSERT_FALSE(bits.Get(1, 128));
+    ASSERT_EQ(bits.Row(1)[2], 2U);
+    bits.Set(1, 129, false);
+    ASSERT_FALSE(bits.Get(1, 129));
+}
+
 TEST(RegexTest, EmptyStringAndEmptyExpression) {
     s21::Regex reg;
     reg.SetString("");
@@ -118,6 +426,39 @@ TEST(RegexTest, ComplexExpression) {
     ASSERT_TRUE(reg.IsMatch());
 }
 
+TEST(RegexTest, LongInputAndMultiWordPattern) {
+    std::string str(100000, 'a');
+    str += "b?c";
+    std::string expr;
+    for (int i = 0; i < 100; i++) expr += "a+";
+    ASSERT_TRUE(s21::Regex::IsMatch(str, expr + "b?c"));
+    ASSERT_TRUE(s21::Regex::IsMatch(str, expr + ".?.?"));
+    ASSERT_FALSE(s21::Regex::IsMatch(str, expr + "b"));
+    ASSERT_TRUE(s21::Regex::IsMatch(str, std::string(70, 'a') + "*c"));
+}
+
+TEST(RegexTest, CompiledCacheMatchesDP) {
+    s21::RegexCache cache(2);
+    auto program = cache.Get("a+b?.*");
+    ASSERT_EQ(cache.Get("a+b?.*"), program);
+    cache.Get("ab");
+    cache.Get("+");
+    ASSERT_EQ(cache.Size(), 2);
+    ASSERT_NE(cache.Get("a+b?.*"), program);
+    for (const char *str : {"", "aab", "ab?xyz", "b", "?"})
+        ASSERT_EQ(program->IsMatch(str), s21::Regex::IsMatch(str, "a+b?.*"));
+    ASSERT_FALSE(cache.Get("+")->IsMatch(""));
+}
+
+TEST(RegexTest, MultiExpressionSinglePass) {
+    s21::Controller controller;
+    std::vector<std::string_view> motifs = {"TATA.A", "GC+AT", "", "AC*", "G+"};
+    ASSERT_EQ(controller.RegularExpressionSet("GCCCAT", motifs),
+              std::vector<bool>({false, true, false, false, false}));
+    ASSERT_EQ(controller.RegularExpressionSet("CCTATAAAGGAT", motifs, true),
+              std::vector<bool>({true, true, true, false, true}));
+}
+
 TEST(RegexTest, FileInputTest) {
     s21::Regex reg;
     reg.ReadFile("../datasets/regex_text.txt");
@@ -142,6 +483,21 @@ TEST(KStringTest, NonAnagrams) {
     ASSERT_EQ(ks.GetDiffCount(), -1);
 }
 
+TEST(KStringTest, StatelessCall) {
+    ASSERT_EQ(s21::KString::GetDiffCount("listen", "nistel"), 1);
+    ASSERT_EQ(s21::KString::GetDiffCount("hello", "world"), -1);
+    ASSERT_TRUE(s21::Regex::IsMatch("aaabcc", "a+b.c*"));
+    ASSERT_EQ(s21::WindowSubstring::GetMinimumWindowSubstring("ADOBECODEBANC", "ABC"), "BANC");
+}
+
+TEST(KStringTest, BatchedPairs) {
+    std::vector<s21::KString::StringPair> pairs = {
+        {"listen", "listen"}, {"listen", "nistel"}, {"hello", "world"}, {"GGCGACACC", "AGCCGCGAC"}};
+    std::vector<int> results(pairs.size());
+    s21::KString::GetDiffCounts(pairs.data(), pairs.size(), results.data(), 3);
+    ASSERT_EQ(results, std::vector<int>({0, 1, -1, 3}));
+}
+
 TEST(KStringTest, FileInputTest) {
     s21::KString ks;
     ks.ReadFile("../datasets/k_strings.txt");
@@ -179,12 +535,179 @@ TEST(WindowSubstringTest, EmptyStringOrPattern) {
     ASSERT_EQ(ws.GetMinimumWindowSubstring(), "");
 }
 
+TEST(WindowSubstringTest, BatchedPairs) {
+    std::vector<s21::WindowSubstring::StringPair> pairs = {
+        {"ADOBECODEBANC", "ABC"}, {"ADOBECODEBANC", "XYZ"}, {"hello", "hello"}, {"GGCGACACCCACCATACAT", "TGT"}};
+    std::vector<std::string_view> results(pairs.size());
+    s21::WindowSubstring::GetMinimumWindowSubstrings(pairs.data(), pairs.size(), results.data(), 2);
+    ASSERT_EQ(results, std::vector<std::string_view>({"BANC", "", "hello", "GACACCCACCATACAT"}));
+}
+
 TEST(WindowSubstringTest, FileInputTest) {
     s21::WindowSubstring ws;
     ws.ReadFile("../datasets/window_substrings.txt");
     ASSERT_EQ(ws.GetMinimumWindowSubstring(), "GACACCCACCATACAT");
 }
 
+TEST(MetricsTest, CountersAndHistogramsExport) {
+    auto &metrics = s21::Metrics::Instance();
+    metrics.GetCounter("test_events_total").Add(3);
+    metrics.GetHistogram("test_sizes").Observe(5);
+    metrics.GetHistogram("test_sizes").Observe(100);
+    ASSERT_EQ(metrics.GetCounter("test_events_total").Value(), 3U);
+    ASSERT_EQ(metrics.GetHistogram("test_sizes").Count(), 2U);
+    ASSERT_EQ(metrics.GetHistogram("test_sizes").Sum(), 105U);
+
+    std::string prom = metrics.ToPrometheus();
+    ASSERT_NE(prom.find("test_events_total 3"), std::string::npos);
+    ASSERT_NE(prom.find("test_sizes_bucket{le=\"8\"} 1"), std::string::npos);
+    ASSERT_NE(prom.find("test_sizes_count 2"), std::string::npos);
+    ASSERT_NE(metrics.ToJson().find("\"test_events_total\":3"), std::string::npos);
+
+    metrics.Reset();
+    ASSERT_EQ(metrics.GetCounter("test_events_total").Value(), 0U);
+}
+
+TEST(QueryServiceTest, BatchedRequests) {
+    s21::QueryService service(2);
+    ASSERT_TRUE(service.LoadReference("text", "../datasets/dna_search_text.txt"));
+    using Algorithm = s21::QueryService::Algorithm;
+    std::vector<s21::QueryService::Request> batch = {
+        {0, Algorithm::kRabinKarp, {"@text", "AAGCCTCAATAAAGCTT"}},
+        {1, Algorithm::kKStrings, {"listen", "nistel"}},
+        {2, Algorithm::kRabinKarp, {"abcdeabcde", "cde"}},
+        {3, Algorithm::kRegex, {"abc", "a.c"}},
+        {4, Algorithm::kWindowSubstring, {"ADOBECODEBANC"}},
+        {5, Algorithm::kRabinKarp, {"@txet", "ACGT"}},
+        {6, Algorithm::kNeedlemanWunsch, {"2", "-1", "-2", "AGTACG", "AGCTCG"}},
+        {7, Algorithm::kKmers, {"ACGTTTACGT", "3", "2"}},
+    };
+    auto responses = service.Process(batch);
+    ASSERT_EQ(responses.size(), 8U);
+    ASSERT_EQ(responses[7].result, "ACG:4 AAA:1");
+    ASSERT_FALSE(responses[5].ok);
+    ASSERT_EQ(responses[5].result, "unknown reference @txet");
+    ASSERT_EQ(responses[6].result.substr(0, 2), "6 ");
+    ASSERT_EQ(responses[0].result, "65 9150");
+    ASSERT_EQ(responses[1].result, "1");
+    ASSERT_EQ(responses[2].result, "2 7");
+    ASSERT_EQ(responses[3].result, "true");
+    ASSERT_FALSE(responses[4].ok);
+    ASSERT_EQ(service.GetLatencyStats().count, 8U);
+}
+
+static std::string MotifText() {
+    std::string text;
+    for (int i = 0; i < 2000; i++) text += i % 7 == 0 ? "ACGTTGCA" : "TTAGGCAT";
+    return text;
+}
+
+TEST(ShardCoordinatorTest, MergesShardsWithGlobalOffsets) {
+    std::string path = (std::filesystem::temp_directory_path() / "s21_shard_test.txt").string();
+    std::string text = MotifText();
+    std::ofstream(path) << text;
+
+    s21::ShardCoordinator coordinator(path, 3, 16);
+    ASSERT_TRUE(coordinator.IsRunning());
+    ASSERT_EQ(coordinator.Workers(), 3);
+    for (auto engine : {s21::ShardCoordinator::Engine::kExact, s21::ShardCoordinator::Engine::kMismatch}) {
+        auto hits = coordinator.Search("GTTGCATT", engine, 1);
+        ASSERT_TRUE(hits.has_value());
+        std::list<s21::ApproximateHit> expected = s21::ApproximateSearch::Search(
+            text, "GTTGCATT", engine == s21::ShardCoordinator::Engine::kExact ? 0 : 1);
+        ASSERT_EQ(hits->size(), expected.size());
+        auto it = expected.begin();
+        for (const auto &hit : *hits) {
+            ASSERT_EQ(hit.position, static_cast<std::uint64_t>(it->position));
+            ASSERT_EQ(hit.distance, (it++)->distance);
+        }
+    }
+    auto iupac = coordinator.Search("NCGTKG", s21::ShardCoordinator::Engine::kIupac);
+    ASSERT_EQ(iupac->size(), s21::RabinKarp::Search(text, "ACGTTG").size());
+    ASSERT_FALSE(coordinator.Search(std::string(17, 'A')).has_value());
+    ASSERT_THROW(s21::ShardCoordinator("../datasets/missing.txt", 2), std::ios_base::failure);
+
+    s21::Controller controller;
+    ASSERT_FALSE(controller.AlgorithmShardSearch("GTTGCATT").has_value());
+    controller.StartShards(path, 2);
+    ASSERT_EQ(controller.AlgorithmShardSearch("GTTGCATT")->size(), s21::RabinKarp::Search(text, "GTTGCATT").size());
+    std::filesystem::remove(path);
+}
+
+TEST(JobRunnerTest, ResumesAlignmentsWithoutDuplicates) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string output = (dir / "s21_job_align.tsv").string();
+    std::string checkpoint = (dir / "s21_job_align.ckpt").string();
+    std::string reference = (dir / "s21_job_align_ref.tsv").string();
+    std::filesystem::remove(checkpoint);
+    std::vector<std::string> sequences = {"AGTACG", "AGCTCG", "GGGCGACACT", "TTACG", "ACG", "GATTACA"};
+    s21::JobRunner::Options options;
+    options.memory_budget = 200;
+    options.checkpoint_every = 1;
+    options.max_units = 2;
+
+    s21::Controller controller;
+    auto first = controller.AlgorithmNWJob(sequences, -2, 1, -1, output, checkpoint, options);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(first->next_unit, 2U);
+    ASSERT_FALSE(first->Done());
+    std::ofstream(output, std::ios::app) << "0\t1\tpartial";
+
+    options.max_units = std::numeric_limits<std::size_t>::max();
+    auto second = controller.AlgorithmNWJob(sequences, -2, 1, -1, output, checkpoint, options);
+    ASSERT_TRUE(second.has_value() && second->Done());
+    ASSERT_EQ(second->total_units, 15U);
+
+    std::filesystem::remove(checkpoint);
+    controller.AlgorithmNWJob(sequences, -2, 1, -1, reference, checkpoint, options);
+    std::ifstream resumed(output), fresh(reference);
+    std::string line, expected, last;
+    std::size_t lines = 0;
+    while (std::getline(fresh, expected)) {
+        ASSERT_TRUE(std::getline(resumed, line));
+        ASSERT_EQ(line, expected);
+        last = line;
+        lines++;
+    }
+    ASSERT_FALSE(std::getline(resumed, line));
+    ASSERT_EQ(lines, 15U);
+    int score = s21::NeedlemanWunsch::AlignCigar("ACG", "GATTACA", {1, -1, -2}).optimal_score;
+    ASSERT_EQ(last.substr(0, last.rfind('\t')), "4\t5\t" + std::to_string(score));
+    for (const auto &path : {output, checkpoint, reference}) std::filesystem::remove(path);
+}
+
+TEST(JobRunnerTest, ResumesShardedScan) {
+    auto dir = std::filesystem::temp_directory_path();
+    std::string path = (dir / "s21_job_text.txt").string();
+    std::string output = (dir / "s21_job_scan.tsv").string();
+    std::string checkpoint = (dir / "s21_job_scan.ckpt").string();
+    std::filesystem::remove(checkpoint);
+    std::string text = MotifText();
+    std::ofstream(path) << text;
+
+    s21::JobRunner::Options options;
+    options.memory_budget = 0;
+    options.max_units = 5;
+    auto partial = s21::JobRunner(output, checkpoint, options).ScanFile(path, {"GTTGCATT", "GCAT"});
+    ASSERT_TRUE(partial.has_value() && !partial->Done());
+    options.max_units = std::numeric_limits<std::size_t>::max();
+    auto done = s21::JobRunner(output, checkpoint, options).ScanFile(path, {"GTTGCATT", "GCAT"});
+    ASSERT_TRUE(done.has_value() && done->Done());
+
+    std::vector<std::list<std::size_t>> found(2);
+    std::ifstream file(output);
+    std::size_t pattern = 0, position = 0;
+    while (file >> pattern >> position) found[pattern].push_back(position);
+    std::vector<std::string> patterns = {"GTTGCATT", "GCAT"};
+    for (std::size_t p = 0; p < patterns.size(); p++) {
+        auto expected = s21::RabinKarp::Search(text, patterns[p]);
+        ASSERT_EQ(found[p].size(), expected.size());
+        ASSERT_TRUE(std::equal(expected.begin(), expected.end(), found[p].begin(),
+                               [](int a, std::size_t b) { return static_cast<std::size_t>(a) == b; }));
+    }
+    for (const auto &name : {path, output, checkpoint}) std::filesystem::remove(name);
+}
+
 int main(int argc, char* argv[]) {
     testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();